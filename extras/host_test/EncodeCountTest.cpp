@@ -0,0 +1,142 @@
+/**
+ ******************************************************************************
+ * @file    EncodeCountTest.cpp
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   Check that writing a message on the tag computes each record length once.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "M24SR.h"
+#include "NDefNfcTagM24SR.h"
+#include "RecordGeo.h"
+#include "RecordMail.h"
+#include "RecordSMS.h"
+#include "RecordText.h"
+#include "RecordURI.h"
+#include "M24SREmulator.h"
+
+using namespace NDefLib;
+
+/**
+ * Record that counts the calls to the length and encode functions.
+ */
+template<typename RecordClass>
+class CountingRecord: public RecordClass {
+public:
+
+	using RecordClass::RecordClass;
+
+	virtual uint32_t get_byte_length() {
+		nLengthCalls++;
+		return RecordClass::get_byte_length();
+	}
+
+	virtual uint16_t write(uint8_t *buffer) {
+		nWriteCalls++;
+		return RecordClass::write(buffer);
+	}
+
+	unsigned int nLengthCalls = 0;
+	unsigned int nWriteCalls = 0;
+};
+
+int main() {
+	TwoWire i2c;
+	M24SR device(0xAC, &i2c, NULL, 0, 0);
+	device.begin(NULL);
+	NDefNfcTag &tag = *device.get_NDef_tag();
+	int failures = 0;
+
+	CountingRecord<RecordText> text("text record");
+	CountingRecord<RecordURI> uri(RecordURI::HTTP_WWW, "st.com");
+	CountingRecord<RecordSMS> sms("123456", "sms");
+	CountingRecord<RecordMail> mail("a@b.com", "subject", "body");
+	CountingRecord<RecordGeo> geo(45.1f, 9.2f);
+	Message msg;
+	msg.add_record(&text);
+	msg.add_record(&uri);
+	msg.add_record(&sms);
+	msg.add_record(&mail);
+	msg.add_record(&geo);
+
+	for (int i = 0; i < 3; i++) {
+		//change the content, the lengths must be computed again
+		if (i == 1) {
+			text.set_text("text record, longer");
+			uri.set_content("st.com/content/st_com/en.html");
+			sms.set_message("longer sms");
+			mail.set_subject("longer subject");
+			geo.set_latitude(-45.123456f);
+		}//if
+
+		text.nLengthCalls = text.nWriteCalls = 0;
+		uri.nLengthCalls = uri.nWriteCalls = 0;
+		sms.nLengthCalls = sms.nWriteCalls = 0;
+		mail.nLengthCalls = mail.nWriteCalls = 0;
+		geo.nLengthCalls = geo.nWriteCalls = 0;
+
+		tag.open_session();
+		const bool written = tag.write(msg);
+		tag.close_session();
+
+		const unsigned int lengthCalls[] = { text.nLengthCalls,
+				uri.nLengthCalls, sms.nLengthCalls, mail.nLengthCalls,
+				geo.nLengthCalls };
+		const unsigned int writeCalls[] = { text.nWriteCalls, uri.nWriteCalls,
+				sms.nWriteCalls, mail.nWriteCalls, geo.nWriteCalls };
+		std::printf("write %d: length calls", i);
+		for (unsigned int r = 0; r < msg.get_N_records(); r++)
+			std::printf(" %u", lengthCalls[r]);
+		std::printf(", encode calls");
+		for (unsigned int r = 0; r < msg.get_N_records(); r++)
+			std::printf(" %u", writeCalls[r]);
+		std::printf("\n");
+
+		//one size pass for the buffer allocation and one encode pass
+		if (!written)
+			failures++;
+		for (unsigned int r = 0; r < msg.get_N_records(); r++)
+			if (lengthCalls[r] != 1 || writeCalls[r] != 1)
+				failures++;
+
+		uint8_t expected[256];
+		const uint16_t length = msg.write(expected);
+		if (std::memcmp(M24SREmulator::get_NDEF_file(), expected, length) != 0)
+			failures++;
+	}//for
+
+	std::printf("%s\n", failures == 0 ? "OK" : "FAILED");
+	return failures == 0 ? 0 : 1;
+}
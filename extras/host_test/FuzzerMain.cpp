@@ -0,0 +1,84 @@
+/**
+ ******************************************************************************
+ * @file    FuzzerMain.cpp
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   Run a fuzz target on random mutations of its seed, without libFuzzer.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+/**
+ * Valid input of the fuzz target, defined next to LLVMFuzzerTestOneInput.
+ */
+std::vector<uint8_t> fuzzer_seed();
+
+//default number of mutated inputs
+#define N_RUNS 100000
+
+int main(int argc, char **argv) {
+	const unsigned long nRuns = argc > 1 ? std::strtoul(argv[1], NULL, 10) : N_RUNS;
+	const std::vector<uint8_t> seed = fuzzer_seed();
+
+	LLVMFuzzerTestOneInput(seed.data(), seed.size());
+
+	std::srand(1);
+	for (unsigned long i = 0; i < nRuns; i++) {
+		std::vector<uint8_t> input(seed);
+		if (std::rand() % 8 == 0)
+			input.resize(std::rand() % (seed.size() + 1));
+		const int nMutations = 1 + std::rand() % 4;
+		for (int j = 0; j < nMutations && !input.empty(); j++) {
+			const size_t pos = std::rand() % input.size();
+			switch (std::rand() % 3) {
+				case 0:
+					input[pos] = (uint8_t) std::rand();
+					break;
+				case 1:
+					input[pos] ^= 1 << (std::rand() % 8);
+					break;
+				default:
+					input[pos] = std::rand() % 2 ? 0x00 : 0xFF;
+			} //switch
+		} //for
+		LLVMFuzzerTestOneInput(input.data(), input.size());
+	} //for
+
+	std::printf("%lu inputs, OK\n", nRuns);
+	return 0;
+}
@@ -0,0 +1,156 @@
+/**
+ ******************************************************************************
+ * @file    GeoCodecBench.cpp
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   Compare the RecordGeo fixed-point codec with the sprintf/sscanf one.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Message.h"
+#include "RecordGeo.h"
+
+using namespace NDefLib;
+
+//number of coordinates encoded and decoded
+#define N_POINTS 20000
+
+/**
+ * Content written by RecordGeo before the fixed-point codec.
+ */
+static void old_encode(const float lat, const float lon, std::string &content) {
+	char buffer[2 * (1 + 3 + 1 + 4) + 1 + 1];
+	std::sprintf(buffer, "%3.4f,%3.4f", lat, lon);
+	content.clear();
+	content.append(buffer);
+}
+
+/**
+ * Content read by RecordGeo before the fixed-point codec; the old parse
+ * allocated the record as the new one does.
+ */
+static bool old_decode(const char *content, const uint16_t length, float &lat,
+		float &lon) {
+	const std::string uriContent(content, length);
+	if (std::sscanf(uriContent.c_str(), "%f,%f", &lat, &lon) != 2)
+		return false;
+	delete new RecordGeo(lat, lon);
+	return true;
+}
+
+static double elapsed_ns(const std::chrono::steady_clock::time_point &start) {
+	return std::chrono::duration<double, std::nano>(
+			std::chrono::steady_clock::now() - start).count() / N_POINTS;
+}
+
+int main() {
+	//the error is measured against the float given to the codec
+	std::vector<float> lats(N_POINTS), lons(N_POINTS);
+	for (unsigned int i = 0; i < N_POINTS; i++) {
+		lats[i] = -90.0 + 180.0 * ((i * 7919u) % N_POINTS) / N_POINTS;
+		lons[i] = -180.0 + 360.0 * ((i * 104729u) % N_POINTS) / N_POINTS
+				+ 0.0000321;
+	}//for
+
+	//old codec
+	std::vector<std::string> oldContent(N_POINTS);
+	std::vector<std::vector<uint8_t> > oldWritten(N_POINTS);
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (unsigned int i = 0; i < N_POINTS; i++) {
+		old_encode(lats[i], lons[i], oldContent[i]);
+		oldWritten[i].assign(oldContent[i].begin(), oldContent[i].end());
+	}//for
+	const double oldEncodeNs = elapsed_ns(start);
+
+	unsigned long oldBytes = 0;
+	double oldError = 0;
+	start = std::chrono::steady_clock::now();
+	for (unsigned int i = 0; i < N_POINTS; i++) {
+		float lat, lon;
+		if (!old_decode(oldContent[i].data(), oldContent[i].size(), lat, lon))
+			return 1;
+		oldError = std::max(oldError, std::fabs((double) lat - lats[i]));
+		oldError = std::max(oldError, std::fabs((double) lon - lons[i]));
+		oldBytes += oldContent[i].size();
+	}//for
+	const double oldDecodeNs = elapsed_ns(start);
+
+	std::printf("codec          content B  encode ns  decode ns  max error deg\n");
+	std::printf("sprintf %%3.4f   %9.2f  %9.1f  %9.1f  %13.7f\n",
+			(double) oldBytes / N_POINTS, oldEncodeNs, oldDecodeNs, oldError);
+
+	//fixed-point codec, with the default and the maximum precision
+	static const uint8_t precisions[] = { RecordGeo::DEFAULT_PRECISION,
+			RecordGeo::MAX_PRECISION };
+	for (unsigned int p = 0; p < sizeof(precisions); p++) {
+		RecordGeo record(0, 0);
+		record.set_precision(precisions[p]);
+		std::vector<std::vector<uint8_t> > written(N_POINTS);
+
+		start = std::chrono::steady_clock::now();
+		for (unsigned int i = 0; i < N_POINTS; i++) {
+			record.set_latitude(lats[i]);
+			record.set_longitude(lons[i]);
+			written[i].resize(record.get_byte_length());
+			record.write(&written[i][0]);
+		}//for
+		const double encodeNs = elapsed_ns(start);
+
+		unsigned long bytes = 0;
+		double error = 0;
+		start = std::chrono::steady_clock::now();
+		for (unsigned int i = 0; i < N_POINTS; i++) {
+			RecordHeader header;
+			const uint16_t headerLength = header.load_header(&written[i][0]);
+			RecordGeo *parsed = RecordGeo::parse(header,
+					&written[i][headerLength]);
+			if (parsed == NULL)
+				return 1;
+			error = std::max(error, std::fabs((double) parsed->get_latitude() - lats[i]));
+			error = std::max(error, std::fabs((double) parsed->get_longitude() - lons[i]));
+			bytes += parsed->get_content().size();
+			delete parsed;
+		}//for
+		const double decodeNs = elapsed_ns(start);
+
+		std::printf("fixed %u dec     %9.2f  %9.1f  %9.1f  %13.7f\n",
+				precisions[p], (double) bytes / N_POINTS, encodeNs, decodeNs,
+				error);
+	}//for
+
+	return 0;
+}
@@ -0,0 +1,351 @@
+/**
+ ******************************************************************************
+ * @file    M24SREmulator.cpp
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   Host emulator of the M24SR I2C interface, used by the host tests.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+#include <cstring>
+#include <vector>
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "M24SREmulator.h"
+
+namespace M24SREmulator {
+
+//file identifiers
+#define SYSTEM_FILE_ID 0xE101
+#define CC_FILE_ID 0xE103
+#define NDEF_FILE_ID 0x0001
+
+//status words
+#define SW_OK 0x9000
+#define SW_PASSWORD_REQUIRED 0x6300
+#define SW_WRONG_PASSWORD 0x63C2
+#define SW_SECURITY_NOT_SATISFIED 0x6982
+#define SW_FILE_NOT_FOUND 0x6A82
+
+//time needed to transfer a byte on the bus, in microseconds
+#define BYTE_TRANSFER_US 25
+//time needed to execute a command, in microseconds
+#define COMMAND_US 500
+
+static uint8_t sSystemFile[18] = { 0x00, 0x12, 0x00, 0x00, 0x11, 0x00, 0x00,
+		0x00, 0x02, 0xC4, 0x00, 0x01, 0x02, 0x03, 0x04, 0x20, 0x00, 0xB4 };
+static uint8_t sCCFile[15] = { 0x00, 0x0F, 0x20, 0x00, 0xF6, 0x00, 0xF6, 0x04,
+		0x06, 0x00, 0x01, 0x20, 0x00, 0x00, 0x00 };
+static std::vector<uint8_t> sNDEFFile(NDEF_FILE_LENGTH, 0);
+
+//index 0 is not used, see READ_PASSWORD, WRITE_PASSWORD and I2C_PASSWORD
+static uint8_t sPasswords[4][PASSWORD_LENGTH];
+static bool sVerified[4];
+static bool sVerificationRequired[3];
+
+static uint8_t *sSelectedFile = NULL;
+static uint16_t sSelectedFileLength = 0;
+
+static std::vector<uint8_t> sRequest;
+static std::vector<uint8_t> sResponse;
+static size_t sResponseOffset = 0;
+static size_t sResponseLength = 0;
+
+static Stats_t sStats;
+static unsigned long sTimeUs = 0;
+
+const Stats_t& get_stats() {
+	return sStats;
+}
+
+void reset_stats() {
+	sStats = Stats_t();
+}
+
+uint8_t* get_NDEF_file() {
+	return sNDEFFile.data();
+}
+
+uint8_t* get_system_file() {
+	return sSystemFile;
+}
+
+const uint8_t* get_password(uint8_t pwdId) {
+	return sPasswords[pwdId];
+}
+
+bool is_verification_required(uint8_t pwdId) {
+	return sVerificationRequired[pwdId];
+}
+
+/**
+ * @return true if the password is verified, or not needed to access the NDEF file
+ */
+static bool has_access(uint8_t pwdId) {
+	if (sVerified[I2C_PASSWORD] || sVerified[pwdId])
+		return true;
+	return pwdId != I2C_PASSWORD && !sVerificationRequired[pwdId];
+}
+
+/**
+ * Verified passwords are valid until the session ends.
+ */
+static void end_session() {
+	memset(sVerified, 0, sizeof(sVerified));
+}
+
+/**
+ * ISO/IEC 14443 CRC_A.
+ */
+static uint16_t crc(const uint8_t *data, size_t length) {
+	uint16_t crc = 0x6363;
+	for (size_t i = 0; i < length; i++) {
+		uint8_t ch = data[i] ^ (uint8_t) (crc & 0xFF);
+		ch = ch ^ (ch << 4);
+		crc = (crc >> 8) ^ ((uint16_t) ch << 8) ^ ((uint16_t) ch << 3)
+				^ ((uint16_t) ch >> 4);
+	} //for
+	return crc;
+}
+
+static void reply(uint8_t pcb, const uint8_t *data, size_t length,
+		uint16_t sw) {
+	sResponse.clear();
+	sResponse.push_back(pcb);
+	sResponse.insert(sResponse.end(), data, data + length);
+	sResponse.push_back(sw >> 8);
+	sResponse.push_back(sw & 0xFF);
+	const uint16_t c = crc(sResponse.data(), sResponse.size());
+	sResponse.push_back(c & 0xFF);
+	sResponse.push_back(c >> 8);
+}
+
+static void select(uint8_t pcb, const uint8_t *apdu) {
+	//the application id is 7 bytes long, a file id 2
+	if (apdu[4] == 7)
+		return reply(pcb, NULL, 0, SW_OK);
+	const uint16_t fileId = (apdu[5] << 8) | apdu[6];
+	switch (fileId) {
+		case SYSTEM_FILE_ID:
+			sSelectedFile = sSystemFile;
+			sSelectedFileLength = sizeof(sSystemFile);
+			break;
+		case CC_FILE_ID:
+			sSelectedFile = sCCFile;
+			sSelectedFileLength = sizeof(sCCFile);
+			break;
+		case NDEF_FILE_ID:
+			sSelectedFile = sNDEFFile.data();
+			sSelectedFileLength = NDEF_FILE_LENGTH;
+			break;
+		default:
+			return reply(pcb, NULL, 0, SW_FILE_NOT_FOUND);
+	} //switch
+	reply(pcb, NULL, 0, SW_OK);
+}
+
+static void update(uint8_t pcb, const uint8_t *apdu) {
+	const uint16_t offset = (apdu[2] << 8) | apdu[3];
+	const uint8_t length = apdu[4];
+	sStats.updates++;
+	if (sSelectedFile == NULL || offset + length > sSelectedFileLength)
+		return reply(pcb, NULL, 0, SW_FILE_NOT_FOUND);
+	if (!has_access(
+			sSelectedFile == sSystemFile ? I2C_PASSWORD : WRITE_PASSWORD))
+		return reply(pcb, NULL, 0, SW_SECURITY_NOT_SATISFIED);
+	memcpy(sSelectedFile + offset, apdu + 5, length);
+	sStats.updatedBytes += length;
+	if (length != 0) {
+		const uint32_t nPages = (offset + length - 1) / PAGE_SIZE
+				- offset / PAGE_SIZE + 1;
+		sStats.programmedPages += nPages;
+		sTimeUs += nPages * PAGE_PROGRAM_US;
+	} //if
+	reply(pcb, NULL, 0, SW_OK);
+}
+
+static void read(uint8_t pcb, const uint8_t *apdu) {
+	const uint16_t offset = (apdu[2] << 8) | apdu[3];
+	const uint8_t length = apdu[4];
+	sStats.reads++;
+	if (sSelectedFile == NULL || offset + length > sSelectedFileLength)
+		return reply(pcb, NULL, 0, SW_FILE_NOT_FOUND);
+	if (sSelectedFile == sNDEFFile.data() && !has_access(READ_PASSWORD))
+		return reply(pcb, NULL, 0, SW_SECURITY_NOT_SATISFIED);
+	reply(pcb, sSelectedFile + offset, length, SW_OK);
+}
+
+static void verify(uint8_t pcb, const uint8_t *apdu) {
+	const uint8_t pwdId = apdu[3];
+	sStats.verifies++;
+	if (pwdId < READ_PASSWORD || pwdId > I2C_PASSWORD)
+		return reply(pcb, NULL, 0, SW_FILE_NOT_FOUND);
+	//without password the command asks if the password is needed
+	if (sRequest.size() == 1 + 5 + 2)
+		return reply(pcb, NULL, 0,
+				has_access(pwdId) ? SW_OK : SW_PASSWORD_REQUIRED);
+	if (memcmp(apdu + 5, sPasswords[pwdId], PASSWORD_LENGTH) != 0)
+		return reply(pcb, NULL, 0, SW_WRONG_PASSWORD);
+	sVerified[pwdId] = true;
+	reply(pcb, NULL, 0, SW_OK);
+}
+
+static void change_password(uint8_t pcb, const uint8_t *apdu) {
+	const uint8_t pwdId = apdu[3];
+	sStats.passwordChanges++;
+	if (pwdId != READ_PASSWORD && pwdId != WRITE_PASSWORD)
+		return reply(pcb, NULL, 0, SW_FILE_NOT_FOUND);
+	if (!sVerified[WRITE_PASSWORD] && !sVerified[I2C_PASSWORD])
+		return reply(pcb, NULL, 0, SW_SECURITY_NOT_SATISFIED);
+	memcpy(sPasswords[pwdId], apdu + 5, PASSWORD_LENGTH);
+	reply(pcb, NULL, 0, SW_OK);
+}
+
+static void set_requirement(uint8_t pcb, const uint8_t *apdu, bool required) {
+	const uint8_t pwdId = apdu[3];
+	sStats.requirementChanges++;
+	if (pwdId != READ_PASSWORD && pwdId != WRITE_PASSWORD)
+		return reply(pcb, NULL, 0, SW_FILE_NOT_FOUND);
+	if (!sVerified[WRITE_PASSWORD] && !sVerified[I2C_PASSWORD])
+		return reply(pcb, NULL, 0, SW_SECURITY_NOT_SATISFIED);
+	sVerificationRequired[pwdId] = required;
+	reply(pcb, NULL, 0, SW_OK);
+}
+
+/**
+ * Execute the frame in sRequest and prepare the answer in sResponse.
+ */
+static void execute() {
+	sStats.frames++;
+	sStats.busBytes += sRequest.size();
+	sTimeUs += COMMAND_US + sRequest.size() * BYTE_TRANSFER_US;
+	sResponse.clear();
+
+	//GetSession and KillSession: no answer
+	if (sRequest.size() == 1)
+		return end_session();
+	const uint8_t pcb = sRequest[0];
+	//S-block deselect
+	if (pcb == 0xC2) {
+		end_session();
+		sResponse.push_back(0xC2);
+		sResponse.push_back(0xE0);
+		sResponse.push_back(0xB4);
+		return;
+	}
+	//S-block WTX
+	if (pcb == 0xF2)
+		return reply(0xF2, NULL, 0, SW_OK);
+	if (crc(sRequest.data(), sRequest.size()) != 0)
+		return;
+
+	const uint8_t *apdu = sRequest.data() + 1;
+	switch (apdu[1]) {
+		case 0xA4:
+			return select(pcb, apdu);
+		case 0xB0:
+			return read(pcb, apdu);
+		case 0xD6:
+			return update(pcb, apdu);
+		case 0x20:
+			return verify(pcb, apdu);
+		case 0x24:
+			return change_password(pcb, apdu);
+		case 0x26:
+			return set_requirement(pcb, apdu, false);
+		case 0x28:
+			return set_requirement(pcb, apdu, true);
+		default:
+			return reply(pcb, NULL, 0, SW_OK);
+	} //switch
+}
+
+} /* namespace M24SREmulator */
+
+using namespace M24SREmulator;
+
+void pinMode(int, int) { }
+void digitalWrite(int, int) { }
+int digitalRead(int) {
+	return HIGH;
+}
+void attachInterrupt(int, void (*)(), int) { }
+int digitalPinToInterrupt(int pin) {
+	return pin;
+}
+void delay(unsigned long ms) {
+	sTimeUs += ms * 1000;
+}
+unsigned long micros() {
+	return sTimeUs;
+}
+unsigned long millis() {
+	return sTimeUs / 1000;
+}
+
+void TwoWire::begin() { }
+
+void TwoWire::beginTransmission(uint8_t) {
+	sRequest.clear();
+}
+
+size_t TwoWire::write(uint8_t data) {
+	sRequest.push_back(data);
+	return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t length) {
+	sRequest.insert(sRequest.end(), data, data + length);
+	return length;
+}
+
+uint8_t TwoWire::endTransmission(bool) {
+	execute();
+	return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t, uint8_t length, uint8_t) {
+	sTimeUs += length * BYTE_TRANSFER_US;
+	sResponseOffset = 0;
+	sResponseLength = length;
+	if (sResponse.size() < length)
+		sResponse.resize(length, 0xFF);
+	return length;
+}
+
+int TwoWire::available() {
+	return (int) (sResponseLength - sResponseOffset);
+}
+
+int TwoWire::read() {
+	return sResponse[sResponseOffset++];
+}
@@ -0,0 +1,115 @@
+/**
+ ******************************************************************************
+ * @file    M24SREmulator.h
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   Host emulator of the M24SR I2C interface, used by the host tests.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+#ifndef HOST_TEST_M24SREMULATOR_H_
+#define HOST_TEST_M24SREMULATOR_H_
+
+#include <stdint.h>
+
+/**
+ * Emulates the M24SR commands used by the library: session, deselect, select,
+ * read, update, verify, change reference data and enable/disable verification
+ * requirement. The NDEF file is 8 KB, all the passwords start as 16 zero bytes.
+ * @par A verified password is valid until the next session or deselect; the
+ * I2C password grants every access right.
+ * @par The bus time is modeled as 500us for each command, 25us for each
+ * transferred byte and PAGE_PROGRAM_US for each EEPROM page touched by an
+ * UpdateBinary, so micros() measures the cost of a command sequence.
+ */
+namespace M24SREmulator {
+
+/** size of the emulated NDEF file */
+static const uint16_t NDEF_FILE_LENGTH = 8192;
+
+/** EEPROM page size used by the timing model */
+static const uint16_t PAGE_SIZE = 16;
+
+/** time needed to program an EEPROM page, in microseconds */
+static const uint32_t PAGE_PROGRAM_US = 5000;
+
+/** password length */
+static const uint8_t PASSWORD_LENGTH = 16;
+
+/** password ids, as used in the Verify command */
+static const uint8_t READ_PASSWORD = 1;
+static const uint8_t WRITE_PASSWORD = 2;
+static const uint8_t I2C_PASSWORD = 3;
+
+/**
+ * Number of commands received since the last reset_stats.
+ */
+typedef struct {
+	uint32_t frames;         //!< frames sent by the driver
+	uint32_t reads;          //!< ReadBinary commands
+	uint32_t updates;        //!< UpdateBinary commands
+	uint32_t updatedBytes;   //!< bytes written by UpdateBinary
+	uint32_t verifies;       //!< Verify commands
+	uint32_t passwordChanges;//!< ChangeReferenceData commands
+	uint32_t requirementChanges; //!< Enable/DisableVerificationRequirement commands
+	uint32_t busBytes;       //!< bytes sent by the driver
+	uint32_t programmedPages;//!< EEPROM pages written
+} Stats_t;
+
+const Stats_t& get_stats();
+
+void reset_stats();
+
+/**
+ * @return NDEF file content, NDEF_FILE_LENGTH bytes that the tests can change
+ */
+uint8_t* get_NDEF_file();
+
+/**
+ * @return system file content, the tests can change it
+ */
+uint8_t* get_system_file();
+
+/**
+ * @param pwdId READ_PASSWORD, WRITE_PASSWORD or I2C_PASSWORD
+ * @return current password, PASSWORD_LENGTH bytes
+ */
+const uint8_t* get_password(uint8_t pwdId);
+
+/**
+ * @param pwdId READ_PASSWORD or WRITE_PASSWORD
+ * @return true if reading or writing the NDEF file needs the password
+ */
+bool is_verification_required(uint8_t pwdId);
+
+} /* namespace M24SREmulator */
+
+#endif /* HOST_TEST_M24SREMULATOR_H_ */
@@ -0,0 +1,213 @@
+/**
+ ******************************************************************************
+ * @file    MessageFuzzer.cpp
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   Fuzz target of the NDEF message parser.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <cstring>
+#include <vector>
+
+#include "Message.h"
+#include "RecordAlternativeCarrier.h"
+#include "RecordBluetoothOob.h"
+#include "RecordHandover.h"
+#include "RecordSmartPoster.h"
+#include "RecordText.h"
+#include "RecordVCard.h"
+#include "RecordWifiConf.h"
+
+using namespace NDefLib;
+
+std::vector<uint8_t> fuzzer_seed() {
+	const uint8_t address[] = { 0x00, 0x0D, 0x18, 0x01, 0x02, 0x03 };
+
+	//a message with nested and attribute based records
+	RecordText text("hello");
+	text.set_id("t");
+	RecordSmartPoster smartPoster("http://www.st.com");
+	smartPoster.add_title("title");
+	RecordVCard::VCardInfo_t info;
+	info[RecordVCard::NAME] = "Name";
+	RecordVCard vCard(info);
+	RecordWifiConf wifi("ssid", "key");
+	RecordHandover handover;
+	handover.add_alternative_carrier(RecordAlternativeCarrier("bt"));
+	RecordBluetoothOob bluetooth(RecordBluetoothOob::LE, address);
+	bluetooth.set_id("bt");
+	//a payload split in 3 chunks, kept as unknown records
+	static const uint8_t chunked[] = {
+			0xB2, 0x03, 0x02, 'x', '/', 'y', 0x01, 0x02,
+			0x36, 0x00, 0x01, 0x03,
+			0x56, 0x00, 0x01, 0x04 };
+	Message chunks;
+	chunks.parse_message(chunked, sizeof(chunked));
+
+	Message msg;
+	msg.add_record(&text);
+	msg.add_record(&smartPoster);
+	msg.add_record(&vCard);
+	msg.add_record(&wifi);
+	msg.add_record(&handover);
+	msg.add_record(&bluetooth);
+	for (uint32_t i = 0; i < chunks.get_N_records(); i++)
+		msg.add_record(chunks[i]);
+	std::vector<uint8_t> file(msg.get_byte_length());
+	msg.write(file.data());
+	Message::remove_and_delete_all_record(chunks);
+	//the fuzzer input doesn't have the length bytes
+	return std::vector<uint8_t>(file.begin() + 2, file.end());
+}
+
+/**
+ * Tell if a record is written back as it is read: the type, id and payload
+ * are kept without changes.
+ */
+static bool is_kept_as_read(const Record &record) {
+	switch (record.get_type()) {
+		case Record::TYPE_UNKNOWN:
+		case Record::TYPE_AAR:
+		case Record::TYPE_MIME:
+		case Record::TYPE_EXTERNAL:
+		case Record::TYPE_ABSOLUTE_URI:
+			return true;
+		default:
+			return false;
+	}//switch
+}
+
+/**
+ * Tell if a record header is written back as it is read: the short record
+ * and id length flags match the lengths, and the message begin/end flags
+ * match the record position.
+ */
+static bool is_canonical_header(const RecordHeader &header, uint32_t index,
+		uint32_t nRecords) {
+	return header.get_SR() == (header.get_payload_length() <= 255)
+			&& header.get_IL() == (header.get_id_length() != 0)
+			&& header.get_MB() == (index == 0)
+			&& header.get_ME() == (index == nRecords - 1);
+}
+
+/**
+ * Compare each record that is kept as read with the input, and tell if the
+ * whole input is expected to be written back unchanged.
+ * @param input parsed NDEF message
+ * @param output written NDEF message, without the length bytes
+ * @param msg parsed message
+ * @return true if every record and header is written back unchanged
+ */
+static bool compare_records(const uint8_t *input, uint32_t inputLength,
+		const uint8_t *output, uint32_t outputLength, const Message &msg) {
+	bool canonical = true;
+	uint32_t inputOffset = 0, outputOffset = 0;
+	for (uint32_t i = 0; i < msg.get_N_records(); i++) {
+		RecordHeader inputHeader, outputHeader;
+		const uint16_t inputHeaderLength = inputHeader.load_header(
+				input + inputOffset, inputLength - inputOffset);
+		const uint16_t outputHeaderLength = outputHeader.load_header(
+				output + outputOffset, outputLength - outputOffset);
+		if (inputHeaderLength == 0 || outputHeaderLength == 0)
+			__builtin_trap();
+		const uint32_t inputRecordLength = inputHeaderLength
+				+ inputHeader.get_type_length() + inputHeader.get_id_length()
+				+ inputHeader.get_payload_length();
+		const uint32_t outputRecordLength = outputHeaderLength
+				+ outputHeader.get_type_length() + outputHeader.get_id_length()
+				+ outputHeader.get_payload_length();
+
+		if (is_kept_as_read(*msg[i])
+				&& is_canonical_header(inputHeader, i, msg.get_N_records())) {
+			if (inputRecordLength != outputRecordLength
+					|| std::memcmp(input + inputOffset, output + outputOffset,
+							inputRecordLength) != 0)
+				__builtin_trap();
+		} else
+			canonical = false;
+
+		inputOffset += inputRecordLength;
+		outputOffset += outputRecordLength;
+	}//for
+	return canonical;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+	//a NDEF file content, without the 2 length bytes
+	if (size > Message::MAX_BYTE_LENGTH)
+		return 0;
+
+	Message msg;
+	if (Message::parse_message(data, (uint16_t) size, &msg) != Message::PARSE_OK)
+		return 0;
+
+	//a parsed message must be written inside its declared length, and the
+	//written message must be valid; a message without records is written as
+	//an empty record
+	const uint32_t length = msg.get_byte_length();
+	if (length > Message::MAX_BYTE_LENGTH)
+		return 0;
+	std::vector<uint8_t> buffer(length);
+	if (length < 2 || msg.write(buffer.data(), length) != length)
+		__builtin_trap();
+	Message parsed;
+	if (Message::parse_message(buffer.data() + 2, length - 2, &parsed)
+			!= Message::PARSE_OK
+			|| (msg.get_N_records() != 0
+					&& parsed.get_N_records() != msg.get_N_records()))
+		__builtin_trap();
+
+	//the written message is written again byte for byte
+	std::vector<uint8_t> buffer2(parsed.get_byte_length());
+	if (buffer2.size() != length
+			|| parsed.write(buffer2.data(), length) != length
+			|| buffer2 != buffer)
+		__builtin_trap();
+
+	//the input, up to the message end record, is written back unchanged when
+	//the library doesn't normalize it: the seed, or records kept as read
+	static const std::vector<uint8_t> seed = fuzzer_seed();
+	bool unchanged = size == seed.size()
+			&& std::memcmp(data, seed.data(), size) == 0;
+	if (msg.get_N_records() != 0)
+		unchanged = compare_records(data, size, buffer.data() + 2, length - 2,
+				msg) || unchanged;
+	if (unchanged && (length - 2 > size
+			|| std::memcmp(data, buffer.data() + 2, length - 2) != 0))
+		__builtin_trap();
+
+	Message::remove_and_delete_all_record(parsed);
+	Message::remove_and_delete_all_record(msg);
+	return 0;
+}
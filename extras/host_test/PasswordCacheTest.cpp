@@ -0,0 +1,124 @@
+/**
+ ******************************************************************************
+ * @file    PasswordCacheTest.cpp
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   Check that a password is verified once in each I2C session.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "M24SR.h"
+#include "M24SREmulator.h"
+
+static int sFailures = 0;
+
+static void check(bool condition, const char *what) {
+	if (!condition) {
+		std::printf("FAIL: %s\n", what);
+		sFailures++;
+	}//if
+}
+
+/**
+ * Check the number of Verify sent since the last call.
+ */
+static void check_verifies(uint32_t expected, const char *what) {
+	const uint32_t verifies = M24SREmulator::get_stats().verifies;
+	std::printf("%-28s verify %u\n", what, (unsigned int) verifies);
+	check(verifies == expected, what);
+	M24SREmulator::reset_stats();
+}
+
+int main() {
+	static const uint8_t readPassword[16] = { 'r', 'e', 'a', 'd' };
+	static uint8_t writePassword[16] = { 'w', 'r', 'i', 't', 'e' };
+	static const uint8_t wrongPassword[16] = { 'w', 'r', 'o', 'n', 'g' };
+
+	TwoWire i2c;
+	M24SR device(0xAC, &i2c, NULL, 0, 0);
+	device.begin(NULL);
+
+	//two gpo changes in one session
+	check(device.force_get_session() == M24SR::M24SR_SUCCESS, "session");
+	M24SREmulator::reset_stats();
+	check(device.manage_I2C_GPO(M24SR::SESSION_OPENED) == M24SR::M24SR_SUCCESS,
+			"i2c gpo");
+	check(device.manage_RF_GPO(M24SR::WIP) == M24SR::M24SR_SUCCESS, "rf gpo");
+	check_verifies(1, "two gpo changes");
+	check(M24SREmulator::get_system_file()[4] ==
+			((M24SR::WIP << 4) | M24SR::SESSION_OPENED), "gpo configuration");
+
+	//a new session needs a new verify
+	check(device.deselect() == M24SR::M24SR_SUCCESS, "deselect");
+	check(device.get_session() == M24SR::M24SR_SUCCESS, "new session");
+	M24SREmulator::reset_stats();
+	check(device.manage_I2C_GPO(M24SR::HIGH_IMPEDANCE) == M24SR::M24SR_SUCCESS,
+			"i2c gpo in the new session");
+	check_verifies(1, "gpo change, new session");
+
+	//both passwords with the same write password verify
+	check(device.select_application() == M24SR::M24SR_SUCCESS
+			&& device.select_NDEF_file(0x0001) == M24SR::M24SR_SUCCESS,
+			"NDEF file");
+	M24SREmulator::reset_stats();
+	check(device.enable_read_password(M24SR::DEFAULT_PASSWORD, readPassword)
+			== M24SR::M24SR_SUCCESS, "read password");
+	check(device.enable_write_password(M24SR::DEFAULT_PASSWORD, writePassword)
+			== M24SR::M24SR_SUCCESS, "write password");
+	check_verifies(1, "read and write passwords");
+	check(M24SREmulator::is_verification_required(M24SREmulator::READ_PASSWORD)
+			&& M24SREmulator::is_verification_required(
+					M24SREmulator::WRITE_PASSWORD), "password requirements");
+
+	//the changed password is forgotten, a wrong one is never cached
+	check(device.verify(M24SR::WritePwd, 0x10, wrongPassword)
+			!= M24SR::M24SR_SUCCESS, "wrong password");
+	check(device.verify(M24SR::WritePwd, 0x10, wrongPassword)
+			!= M24SR::M24SR_SUCCESS, "wrong password again");
+	check(device.verify(M24SR::WritePwd, 0x10, writePassword)
+			== M24SR::M24SR_SUCCESS, "new write password");
+	check(device.verify(M24SR::WritePwd, 0x10, writePassword)
+			== M24SR::M24SR_SUCCESS, "new write password again");
+	check_verifies(3, "wrong, wrong, right, right");
+
+	device.invalidate_verified_passwords();
+	check(device.verify(M24SR::WritePwd, 0x10, writePassword)
+			== M24SR::M24SR_SUCCESS, "verify after invalidate");
+	check_verifies(1, "after invalidate");
+
+	check(device.deselect() == M24SR::M24SR_SUCCESS, "deselect");
+
+	std::printf("%s\n", sFailures == 0 ? "OK" : "FAILED");
+	return sFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+/**
+ ******************************************************************************
+ * @file    ProbeTest.cpp
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   Check the commands sent by the startup probe.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+#include <cstdio>
+
+#include "M24SR.h"
+#include "M24SREmulator.h"
+
+static int sFailures = 0;
+
+static void check(bool condition, const char *what) {
+	if (!condition) {
+		std::printf("FAIL: %s\n", what);
+		sFailures++;
+	}//if
+}
+
+/**
+ * Check the frames sent since the last call.
+ */
+static void check_frames(uint32_t frames, const char *what) {
+	const M24SREmulator::Stats_t &stats = M24SREmulator::get_stats();
+	std::printf("%-22s frames %u reads %u verify %u updates %u\n", what,
+			(unsigned int) stats.frames, (unsigned int) stats.reads,
+			(unsigned int) stats.verifies, (unsigned int) stats.updates);
+	check(stats.frames == frames, what);
+	M24SREmulator::reset_stats();
+}
+
+int main() {
+	TwoWire i2c;
+	const uint8_t *chipFile = M24SREmulator::get_system_file();
+
+	//session, application, system file, read, verify, update, deselect
+	M24SR device(0xAC, &i2c, NULL, 0, 0);
+	check(device.begin(NULL) == M24SR::M24SR_SUCCESS, "cold start");
+	check_frames(7, "cold start");
+	check(chipFile[4] == ((M24SR::DEFAULT_GPO_STATUS << 4)
+			| M24SR::DEFAULT_GPO_STATUS), "default gpo");
+
+	//the gpo is already correct: no verify and no update
+	M24SR restarted(0xAC, &i2c, NULL, 0, 0);
+	check(restarted.begin(NULL) == M24SR::M24SR_SUCCESS, "restart");
+	check_frames(5, "restart, gpo unchanged");
+
+	//the product code and the memory size come from the probe
+	uint8_t id = 0;
+	check(restarted.read_id(&id) == M24SR::M24SR_SUCCESS
+			&& id == chipFile[0x11], "read id");
+	check(restarted.get_product_code() == chipFile[0x11], "product code");
+	check(restarted.get_memory_size() == ((chipFile[0x0F] << 8) | chipFile[0x10]),
+			"memory size");
+	check_frames(0, "read id");
+
+	std::printf("%s\n", sFailures == 0 ? "OK" : "FAILED");
+	return sFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,170 @@
+/**
+ ******************************************************************************
+ * @file    ProvisioningTest.cpp
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   Provision the emulated chip and check the commands sent and the result.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "M24SR.h"
+#include "Message.h"
+#include "RecordText.h"
+#include "M24SREmulator.h"
+
+using namespace NDefLib;
+
+static int sFailures = 0;
+
+static void check(bool condition, const char *what) {
+	if (!condition) {
+		std::printf("FAIL: %s\n", what);
+		sFailures++;
+	}//if
+}
+
+/**
+ * Run provision and print the report.
+ * @return status returned by provision
+ */
+static M24SR::StatusTypeDef run(M24SR &device,
+		const M24SR::ProvisioningProfile_t &profile, const char *name) {
+	M24SREmulator::reset_stats();
+	const M24SR::StatusTypeDef status = device.provision(profile);
+	const M24SR::ProvisioningReport_t &report =
+			device.get_provisioning_report();
+	std::printf("%-12s status %04X commands %2u frames %2u time %6lu us\n",
+			name, (unsigned int) status, report.nCommands,
+			(unsigned int) M24SREmulator::get_stats().frames,
+			(unsigned long) report.elapsedUs);
+	check(report.status == status, "report status");
+	check(report.nCommands == M24SREmulator::get_stats().frames,
+			"commands counted in the report");
+	return status;
+}
+
+int main() {
+	static const uint8_t readPassword[16] = { 'r', 'e', 'a', 'd', 0x01, 0x02,
+			0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C };
+	static const uint8_t writePassword[16] = { 'w', 'r', 'i', 't', 'e', 0x01,
+			0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B };
+
+	TwoWire i2c;
+	M24SR device(0xAC, &i2c, NULL, 0, 0);
+	device.begin(NULL);
+
+	//NDEF file image that needs 2 UpdateBinary
+	RecordText text(std::string(300, 'p'));
+	Message msg;
+	msg.add_record(&text);
+	static uint8_t image[512];
+	const uint16_t imageLength = msg.write(image);
+
+	M24SR::ProvisioningProfile_t profile;
+	std::memset(&profile, 0, sizeof(profile));
+	profile.ndefFile = image;
+	profile.ndefFileLength = imageLength;
+	profile.newReadPassword = readPassword;
+	profile.newWritePassword = writePassword;
+	profile.setI2CGpo = true;
+	profile.i2cGpo = M24SR::SESSION_OPENED;
+	profile.setRFGpo = true;
+	profile.rfGpo = M24SR::WIP;
+
+	//session, application, NDEF file, verify, 2 updates, 2 password changes
+	//and 2 requirements, system file, read, verify, update, deselect
+	check(run(device, profile, "full") == M24SR::M24SR_SUCCESS, "full profile");
+	check(device.get_provisioning_report().nCommands == 15, "full profile commands");
+	check(std::memcmp(M24SREmulator::get_NDEF_file(), image, imageLength) == 0,
+			"NDEF file");
+	check(std::memcmp(M24SREmulator::get_password(M24SREmulator::READ_PASSWORD),
+			readPassword, sizeof(readPassword)) == 0, "read password");
+	check(std::memcmp(M24SREmulator::get_password(M24SREmulator::WRITE_PASSWORD),
+			writePassword, sizeof(writePassword)) == 0, "write password");
+	check(M24SREmulator::is_verification_required(M24SREmulator::READ_PASSWORD)
+			&& M24SREmulator::is_verification_required(
+					M24SREmulator::WRITE_PASSWORD), "password requirements");
+	check(M24SREmulator::get_system_file()[4] ==
+			((M24SR::WIP << 4) | M24SR::SESSION_OPENED), "gpo configuration");
+
+	//the default write password is not valid anymore: nothing is written
+	M24SR::ProvisioningProfile_t wrongPassword;
+	std::memset(&wrongPassword, 0, sizeof(wrongPassword));
+	const uint8_t emptyFile[2] = { 0x00, 0x00 };
+	wrongPassword.ndefFile = emptyFile;
+	wrongPassword.ndefFileLength = sizeof(emptyFile);
+	check(run(device, wrongPassword, "wrong pwd") != M24SR::M24SR_SUCCESS,
+			"wrong write password");
+	check(std::memcmp(M24SREmulator::get_NDEF_file(), image, imageLength) == 0,
+			"NDEF file after a failed provision");
+
+	//only the gpo: session, application, system file, read, verify, update,
+	//deselect
+	M24SR::ProvisioningProfile_t gpo;
+	std::memset(&gpo, 0, sizeof(gpo));
+	gpo.setI2CGpo = true;
+	gpo.i2cGpo = M24SR::HIGH_IMPEDANCE;
+	check(run(device, gpo, "gpo") == M24SR::M24SR_SUCCESS, "gpo profile");
+	check(device.get_provisioning_report().nCommands == 7, "gpo profile commands");
+	check(M24SREmulator::get_system_file()[4] == (M24SR::WIP << 4),
+			"gpo configuration, only i2c changed");
+
+	//the gpo has already this value: nothing to verify and write
+	check(run(device, gpo, "same gpo") == M24SR::M24SR_SUCCESS,
+			"same gpo profile");
+	check(device.get_provisioning_report().nCommands == 5,
+			"same gpo profile commands");
+
+	//session, application, NDEF file, verify, update, system file, read,
+	//verify, update, deselect
+	M24SR::ProvisioningProfile_t fileAndGpo;
+	std::memset(&fileAndGpo, 0, sizeof(fileAndGpo));
+	fileAndGpo.writePassword = writePassword;
+	fileAndGpo.ndefFile = emptyFile;
+	fileAndGpo.ndefFileLength = sizeof(emptyFile);
+	fileAndGpo.setRFGpo = true;
+	fileAndGpo.rfGpo = M24SR::SESSION_OPENED;
+	check(run(device, fileAndGpo, "file and gpo") == M24SR::M24SR_SUCCESS,
+			"file and gpo profile");
+	check(device.get_provisioning_report().nCommands == 10,
+			"file and gpo profile commands");
+	check(M24SREmulator::get_NDEF_file()[0] == 0
+			&& M24SREmulator::get_NDEF_file()[1] == 0, "empty NDEF file");
+	check(M24SREmulator::get_system_file()[4] == (M24SR::SESSION_OPENED << 4),
+			"gpo configuration, only rf changed");
+
+	std::printf("%s\n", sFailures == 0 ? "OK" : "FAILED");
+	return sFailures == 0 ? 0 : 1;
+}
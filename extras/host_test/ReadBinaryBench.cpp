@@ -0,0 +1,105 @@
+/**
+ ******************************************************************************
+ * @file    ReadBinaryBench.cpp
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   Measure ReadBinary of the whole NDEF file with different slice lengths.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include "M24SR.h"
+#include "M24SREmulator.h"
+
+//number of times the file is read with each slice length
+#define N_PASSES 50
+
+int main() {
+	TwoWire i2c;
+	M24SR device(0xAC, &i2c, NULL, 0, 0);
+	device.begin(NULL);
+
+	uint8_t *file = M24SREmulator::get_NDEF_file();
+	for (uint16_t i = 0; i < M24SREmulator::NDEF_FILE_LENGTH; i++)
+		file[i] = (uint8_t) (i * 7 + (i >> 8));
+
+	if (device.force_get_session() != M24SR::M24SR_SUCCESS
+			|| device.select_application() != M24SR::M24SR_SUCCESS
+			|| device.select_NDEF_file(0x0001) != M24SR::M24SR_SUCCESS) {
+		std::printf("session failed\n");
+		return 1;
+	}
+
+	static uint8_t buffer[M24SREmulator::NDEF_FILE_LENGTH];
+	//246 bytes is the max read length in the emulated CC file
+	const uint8_t sliceLengths[] = { 16, 64, 128, 246 };
+	std::printf("%6s %8s %12s %14s\n", "slice", "reads", "host ns/B",
+			"emulated us");
+	for (unsigned s = 0; s < sizeof(sliceLengths) / sizeof(sliceLengths[0]);
+			s++) {
+		const uint8_t slice = sliceLengths[s];
+		M24SREmulator::reset_stats();
+		const unsigned long start = micros();
+		const std::chrono::steady_clock::time_point hostStart =
+				std::chrono::steady_clock::now();
+		for (int pass = 0; pass < N_PASSES; pass++) {
+			for (uint16_t offset = 0; offset < M24SREmulator::NDEF_FILE_LENGTH;
+					offset += slice) {
+				uint16_t length = M24SREmulator::NDEF_FILE_LENGTH - offset;
+				if (length > slice)
+					length = slice;
+				if (device.read_binary(offset, (uint8_t) length, buffer + offset)
+						!= M24SR::M24SR_SUCCESS) {
+					std::printf("read failed at %u\n", offset);
+					return 1;
+				}
+			} //for
+		} //for
+		const std::chrono::nanoseconds hostTime =
+				std::chrono::steady_clock::now() - hostStart;
+
+		if (std::memcmp(buffer, file, M24SREmulator::NDEF_FILE_LENGTH) != 0) {
+			std::printf("wrong data with slice %u\n", slice);
+			return 1;
+		}
+		std::printf("%6u %8u %12.2f %14lu\n", slice,
+				M24SREmulator::get_stats().reads / N_PASSES,
+				(double) hostTime.count()
+						/ (N_PASSES * M24SREmulator::NDEF_FILE_LENGTH),
+				(micros() - start) / N_PASSES);
+	} //for
+
+	device.deselect();
+	return 0;
+}
@@ -0,0 +1,124 @@
+/**
+ ******************************************************************************
+ * @file    ReadCacheTest.cpp
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   Check when the NDEF read cache is used and when the file is read again.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+#include <cstdio>
+#include <string>
+
+#include "M24SR.h"
+#include "NDefNfcTagM24SR.h"
+#include "RecordText.h"
+#include "M24SREmulator.h"
+
+using namespace NDefLib;
+
+//offset of the text in the NDEF file: length, record header, status and language
+#define TEXT_OFFSET (2 + 4 + 3)
+
+static int sFailures = 0;
+
+static void check(bool condition, const char *what) {
+	if (!condition) {
+		std::printf("FAIL: %s\n", what);
+		sFailures++;
+	}//if
+}
+
+/**
+ * Read the message and check its text and the ReadBinary sent.
+ */
+static void check_read(NDefNfcTag &tag, const std::string &text, uint32_t reads,
+		const char *what) {
+	M24SREmulator::reset_stats();
+	Message msg;
+	const bool read = tag.read(&msg);
+	std::printf("%-32s reads %u\n", what,
+			(unsigned int) M24SREmulator::get_stats().reads);
+	check(read && msg.get_N_records() == 1
+			&& msg[0]->get_type() == Record::TYPE_TEXT
+			&& ((RecordText*) msg[0])->get_text() == text, what);
+	check(M24SREmulator::get_stats().reads == reads, what);
+	Message::remove_and_delete_all_record(msg);
+}
+
+int main() {
+	TwoWire i2c;
+	M24SR device(0xAC, &i2c, NULL, 0, 0);
+	device.begin(NULL);
+	NDefNfcTagM24SR &tag = *(NDefNfcTagM24SR*) device.get_NDef_tag();
+	uint8_t *file = M24SREmulator::get_NDEF_file();
+	tag.set_read_cache(true);
+
+	std::string text(60, 'a');
+	RecordText record(text);
+	Message msg;
+	msg.add_record(&record);
+
+	//the written message is read from the copy
+	tag.open_session();
+	check(tag.write(msg), "write");
+	check_read(tag, text, 0, "read in the same session");
+	tag.close_session();
+
+	//without the rf gpo the copy is not trusted in a new session, also if the
+	//length and the first bytes are unchanged
+	file[TEXT_OFFSET + 40] = text[40] = 'b';
+	tag.open_session();
+	check_read(tag, text, 2, "read in a new session");
+	check_read(tag, text, 0, "read again");
+	tag.close_session();
+
+	//the rf gpo tells when the rf changes the tag
+	check(device.force_get_session() == M24SR::M24SR_SUCCESS
+			&& device.select_application() == M24SR::M24SR_SUCCESS
+			&& device.manage_RF_GPO(M24SR::SESSION_OPENED) == M24SR::M24SR_SUCCESS
+			&& device.deselect() == M24SR::M24SR_SUCCESS, "rf gpo");
+	tag.open_session();
+	check_read(tag, text, 2, "read after the gpo change");
+	tag.close_session();
+	tag.open_session();
+	check_read(tag, text, 0, "read with the rf gpo");
+	tag.close_session();
+
+	file[TEXT_OFFSET + 50] = text[50] = 'c';
+	tag.notify_RF_activity();
+	tag.open_session();
+	check_read(tag, text, 2, "read after the rf activity");
+	tag.close_session();
+
+	std::printf("%s\n", sFailures == 0 ? "OK" : "FAILED");
+	return sFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,222 @@
+/**
+ ******************************************************************************
+ * @file    RecordRoundTripTest.cpp
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   Write a message with every record type and an id, parse it and write it again.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "Message.h"
+#include "RecordAAR.h"
+#include "RecordAbsoluteUri.h"
+#include "RecordAlternativeCarrier.h"
+#include "RecordBluetoothOob.h"
+#include "RecordExternal.h"
+#include "RecordGeo.h"
+#include "RecordHeader.h"
+#include "RecordHandover.h"
+#include "RecordMail.h"
+#include "RecordMimeType.h"
+#include "RecordSMS.h"
+#include "RecordSmartPoster.h"
+#include "RecordText.h"
+#include "RecordURI.h"
+#include "RecordVCard.h"
+#include "RecordWifiConf.h"
+#include "UnknownRecord.h"
+
+using namespace NDefLib;
+
+static int sFailures = 0;
+
+static void check(bool condition, const char *what, unsigned int index) {
+	if (!condition) {
+		std::printf("FAIL record %u: %s\n", index, what);
+		sFailures++;
+	}//if
+}
+
+int main() {
+	const uint8_t data[] = { 0x01, 0x02, 0x03 };
+	const uint8_t address[] = { 0x00, 0x0D, 0x18, 0x01, 0x02, 0x03 };
+
+	RecordText text("hello");
+	RecordURI uri(RecordURI::HTTP_WWW, "st.com");
+	RecordAAR aar("com.st.demo");
+	RecordMimeType mime("application/x-demo", data, sizeof(data));
+	RecordSMS sms("123456", "hi");
+	RecordGeo geo(45.1f, 9.2f);
+	RecordMail mail("a@b.com", "subject", "body");
+	RecordVCard::VCardInfo_t info;
+	info[RecordVCard::NAME] = "Name";
+	RecordVCard vCard(info);
+	RecordWifiConf wifi("ssid", "key");
+	RecordSmartPoster smartPoster("http://www.st.com");
+	smartPoster.add_title("title");
+	RecordExternal external("st.com:demo", data, sizeof(data));
+	RecordAbsoluteUri absoluteUri("http://www.st.com/demo", data, sizeof(data));
+	UnknownRecord unknown(RecordHeader::Unknown, "", "", data, sizeof(data));
+	RecordHandover handover;
+	handover.add_alternative_carrier(RecordAlternativeCarrier("bt"));
+	RecordBluetoothOob bluetooth(RecordBluetoothOob::BR_EDR, address);
+	bluetooth.set_local_name("Speaker");
+
+	Record *records[] = { &text, &uri, &aar, &mime, &sms, &geo, &mail, &vCard,
+			&wifi, &smartPoster, &external, &absoluteUri, &unknown, &handover,
+			&bluetooth };
+	const unsigned int nRecords = sizeof(records) / sizeof(records[0]);
+
+	Message msg;
+	char id[8];
+	for (unsigned int i = 0; i < nRecords; i++) {
+		std::snprintf(id, sizeof(id), "id%u", i);
+		records[i]->set_id(id);
+		msg.add_record(records[i]);
+	}//for
+	//the alternative carrier references the bluetooth record
+	bluetooth.set_id("bt");
+
+	static uint8_t buffer[2048], buffer2[2048];
+	const uint16_t length = msg.write(buffer);
+	check(length == msg.get_byte_length(), "message length", 0);
+
+	Message parsed;
+	check(Message::parse_message(buffer + 2, length - 2, &parsed)
+			== Message::PARSE_OK, "parse", 0);
+	check(parsed.get_N_records() == nRecords, "number of records", 0);
+	for (unsigned int i = 0; i < parsed.get_N_records() && i < nRecords; i++) {
+		check(parsed[i]->get_type() == records[i]->get_type(), "type", i);
+		check(parsed[i]->get_id() == records[i]->get_id(), "id", i);
+	}//for
+
+	const uint16_t length2 = parsed.write(buffer2);
+	check(length == length2 && std::memcmp(buffer, buffer2, length) == 0,
+			"rewritten message", 0);
+	Message::remove_and_delete_all_record(parsed);
+
+	//a chunked payload is kept as unknown records, with the chunk flags
+	static const uint8_t chunked[] = {
+			0x91, 0x01, 0x05, 'T', 0x02, 'e', 'n', 'h', 'i',
+			0x32, 0x12, 0x02, 'a', 'p', 'p', 'l', 'i', 'c', 'a', 't', 'i', 'o',
+			'n', '/', 'x', '-', 'd', 'e', 'm', 'o', 0x01, 0x02,
+			0x36, 0x00, 0x02, 0x03, 0x04,
+			0x56, 0x00, 0x01, 0x05 };
+	Message chunkedMsg;
+	check(chunkedMsg.parse_message(chunked, sizeof(chunked))
+			== Message::PARSE_OK && chunkedMsg.get_N_records() == 4,
+			"chunked message", 0);
+	for (unsigned int i = 1; i < chunkedMsg.get_N_records(); i++)
+		check(chunkedMsg[i]->get_type() == Record::TYPE_UNKNOWN, "chunk type", i);
+	const uint16_t chunkedLength = chunkedMsg.write(buffer);
+	check(chunkedLength == sizeof(chunked) + 2
+			&& std::memcmp(buffer + 2, chunked, sizeof(chunked)) == 0,
+			"rewritten chunked message", 0);
+
+	//the nested records that are not handled are written back
+	static const uint8_t poster[] = {
+			0xD1, 0x02, 0x2D, 'S', 'p',
+			0x91, 0x01, 0x07, 'U', 0x01, 's', 't', '.', 'c', 'o', 'm',
+			0x11, 0x01, 0x05, 'T', 0x02, 'e', 'n', 'h', 'i',
+			0x11, 0x01, 0x02, 'U', 0x00, 'x',
+			0x12, 0x0A, 0x01, 't', 'e', 'x', 't', '/', 'p', 'l', 'a', 'i', 'n',
+			'a',
+			0x51, 0x01, 0x01, 'x', 0x07 };
+	Message posterMsg;
+	check(posterMsg.parse_message(poster, sizeof(poster)) == Message::PARSE_OK
+			&& posterMsg.get_N_records() == 1
+			&& posterMsg[0]->get_type() == Record::TYPE_SMART_POSTER,
+			"smart poster", 0);
+	if (posterMsg.get_N_records() == 1) {
+		const RecordSmartPoster *sp = (const RecordSmartPoster*) posterMsg[0];
+		check(sp->get_N_titles() == 1 && sp->get_icon() == NULL
+				&& sp->get_N_other_records() == 3, "smart poster content", 0);
+		const uint16_t posterLength = posterMsg.write(buffer);
+		check(posterLength == sizeof(poster) + 2
+				&& std::memcmp(buffer + 2, poster, sizeof(poster)) == 0,
+				"rewritten smart poster", 0);
+	}//if
+
+	static const uint8_t select[] = {
+			0xD1, 0x02, 0x16, 'H', 's', 0x13,
+			0x91, 0x02, 0x04, 'a', 'c', 0x01, 0x01, 'b', 0x00,
+			0x54, 0x08, 0x01, 's', 't', '.', 'c', 'o', 'm', ':', 'x', 0x07 };
+	Message selectMsg;
+	check(selectMsg.parse_message(select, sizeof(select)) == Message::PARSE_OK
+			&& selectMsg.get_N_records() == 1
+			&& selectMsg[0]->get_type() == Record::TYPE_HANDOVER,
+			"handover", 0);
+	if (selectMsg.get_N_records() == 1) {
+		const RecordHandover *hs = (const RecordHandover*) selectMsg[0];
+		check(hs->get_N_alternative_carriers() == 1
+				&& hs->get_N_other_records() == 1
+				&& hs->get_other_record(0).get_type_string() == "st.com:x",
+				"handover content", 0);
+		const uint16_t selectLength = selectMsg.write(buffer);
+		check(selectLength == sizeof(select) + 2
+				&& std::memcmp(buffer + 2, select, sizeof(select)) == 0,
+				"rewritten handover", 0);
+	}//if
+
+	//the wifi attributes are written back in the read order
+	static const uint8_t wsc[] = {
+			0xD2, 0x17, 0x2B, 'a', 'p', 'p', 'l', 'i', 'c', 'a', 't', 'i', 'o',
+			'n', '/', 'v', 'n', 'd', '.', 'w', 'f', 'a', '.', 'w', 's', 'c',
+			0x10, 0x49, 0x00, 0x04, 0x00, 0x37, 0x2A, 'v',
+			0x10, 0x0E, 0x00, 0x1F,
+			0x10, 0x27, 0x00, 0x01, 'k',
+			0x10, 0x45, 0x00, 0x01, 's',
+			0x12, 0x34, 0x00, 0x00,
+			0x10, 0x0F, 0x00, 0x02, 0x00, 0x01,
+			0x10, 0x03, 0x00, 0x02, 0x00, 0x00,
+			0x10, 0x26, 0x00, 0x01, 0x01 };
+	Message wscMsg;
+	check(wscMsg.parse_message(wsc, sizeof(wsc)) == Message::PARSE_OK
+			&& wscMsg.get_N_records() == 1
+			&& wscMsg[0]->get_type() == Record::TYPE_WIFI_CONF, "wifi", 0);
+	const uint16_t wscLength = wscMsg.write(buffer);
+	check(wscLength == sizeof(wsc) + 2
+			&& std::memcmp(buffer + 2, wsc, sizeof(wsc)) == 0,
+			"rewritten wifi", 0);
+
+	//a removed id must not be counted
+	RecordHeader header;
+	header.set_id_length(3);
+	header.set_id_length(0);
+	check(!header.get_IL() && header.get_id_length() == 0, "removed id length",
+			0);
+
+	std::printf("%u records, %s\n", nRecords, sFailures == 0 ? "OK" : "FAILED");
+	return sFailures == 0 ? 0 : 1;
+}
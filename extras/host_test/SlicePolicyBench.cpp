@@ -0,0 +1,92 @@
+/**
+ ******************************************************************************
+ * @file    SlicePolicyBench.cpp
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   Compare the NDEF write slice policies on the emulated tag.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+#include <cstdio>
+#include <string>
+
+#include "M24SR.h"
+#include "NDefNfcTagM24SR.h"
+#include "RecordText.h"
+#include "M24SREmulator.h"
+
+using namespace NDefLib;
+
+//number of writes done with each policy, the adaptive one needs some to learn
+#define N_WRITES 8
+
+static const char *sPolicyName[] = { "MAX_SLICE", "PAGE_ALIGNED", "ADAPTIVE" };
+
+int main() {
+	TwoWire i2c;
+	M24SR device(0xAC, &i2c, NULL, 0, 0);
+	device.begin(NULL);
+	NDefNfcTagM24SR &tag = *(NDefNfcTagM24SR*) device.get_NDef_tag();
+
+	const size_t lengths[] = { 100, 900, 4000 };
+	std::printf("%-13s %6s %8s %8s %8s %10s\n", "policy", "bytes", "frames",
+			"updates", "pages", "time(us)");
+	for (unsigned l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+		RecordText record(std::string(lengths[l], 'x'));
+		Message msg;
+		msg.add_record(&record);
+
+		for (int p = NDefNfcTagM24SR::MAX_SLICE; p <= NDefNfcTagM24SR::ADAPTIVE;
+				p++) {
+			tag.set_slice_policy((NDefNfcTagM24SR::SlicePolicy_t) p);
+			tag.open_session();
+			M24SREmulator::Stats_t last;
+			unsigned long elapsed = 0;
+			for (int i = 0; i < N_WRITES; i++) {
+				M24SREmulator::reset_stats();
+				const unsigned long start = micros();
+				if (!tag.write(msg)) {
+					std::printf("write failed\n");
+					return 1;
+				}
+				elapsed = micros() - start;
+				last = M24SREmulator::get_stats();
+			} //for
+			tag.close_session();
+
+			//the last write shows the steady state of the policy
+			std::printf("%-13s %6u %8u %8u %8u %10lu\n", sPolicyName[p],
+					(unsigned) msg.get_byte_length(), last.frames, last.updates,
+					last.programmedPages, elapsed);
+		} //for
+	} //for
+	return 0;
+}
@@ -0,0 +1,123 @@
+/**
+ ******************************************************************************
+ * @file    SystemFileTest.cpp
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   Check the commands sent to read and write the system file copy.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "M24SR.h"
+#include "M24SREmulator.h"
+
+static int sFailures = 0;
+
+static void check(bool condition, const char *what) {
+	if (!condition) {
+		std::printf("FAIL: %s\n", what);
+		sFailures++;
+	}//if
+}
+
+/**
+ * Check the commands sent since the last call.
+ */
+static void check_stats(uint32_t frames, uint32_t reads, uint32_t updatedBytes,
+		const char *what) {
+	const M24SREmulator::Stats_t &stats = M24SREmulator::get_stats();
+	std::printf("%-26s frames %u reads %u verify %u updated bytes %u\n", what,
+			(unsigned int) stats.frames, (unsigned int) stats.reads,
+			(unsigned int) stats.verifies, (unsigned int) stats.updatedBytes);
+	check(stats.frames == frames && stats.reads == reads
+			&& stats.updatedBytes == updatedBytes, what);
+	M24SREmulator::reset_stats();
+}
+
+int main() {
+	TwoWire i2c;
+	M24SR device(0xAC, &i2c, NULL, 0, 0);
+	device.begin(NULL);
+	const uint8_t *chipFile = M24SREmulator::get_system_file();
+	M24SR::SystemFile &systemFile = device.get_system_file();
+
+	check(device.force_get_session() == M24SR::M24SR_SUCCESS
+			&& device.select_application() == M24SR::M24SR_SUCCESS, "session");
+	M24SREmulator::reset_stats();
+
+	//the application is selected: select the file and read it once
+	check(device.read_system_file() == M24SR::M24SR_SUCCESS, "read");
+	check_stats(2, 1, 0, "first read");
+	check(systemFile.is_valid()
+			&& std::memcmp(systemFile.get_UID(), chipFile + 8,
+					M24SR::SystemFile::UID_LENGTH) == 0
+			&& systemFile.get_memory_size() == ((chipFile[15] << 8) | chipFile[16]),
+			"copy content");
+	check(device.read_system_file() == M24SR::M24SR_SUCCESS, "read again");
+	uint8_t id = 0;
+	check(device.read_id(&id) == M24SR::M24SR_SUCCESS && id == chipFile[0x11],
+			"read id");
+	check_stats(0, 0, 0, "read again and read id");
+
+	//one verify and one update with the changed range only
+	systemFile.set_I2C_watchdog(0x05);
+	systemFile.set_I2C_GPO(M24SR::SESSION_OPENED);
+	check(device.write_system_file() == M24SR::M24SR_SUCCESS, "write");
+	check_stats(2, 0, 2, "write 2 bytes");
+	check(chipFile[3] == 0x05 && chipFile[4] == M24SR::SESSION_OPENED,
+			"written bytes");
+
+	//the gpo already has this value
+	check(device.manage_I2C_GPO(M24SR::SESSION_OPENED) == M24SR::M24SR_SUCCESS,
+			"same gpo");
+	check_stats(0, 0, 0, "same gpo");
+	//the I2C password is still verified
+	check(device.manage_RF_GPO(M24SR::WIP) == M24SR::M24SR_SUCCESS, "rf gpo");
+	check_stats(1, 0, 1, "rf gpo");
+	check(chipFile[4] == ((M24SR::WIP << 4) | M24SR::SESSION_OPENED),
+			"rf gpo written");
+
+	//a new session reads the file again
+	check(device.deselect() == M24SR::M24SR_SUCCESS, "deselect");
+	check(!systemFile.is_valid(), "copy dropped by deselect");
+	check(device.get_session() == M24SR::M24SR_SUCCESS
+			&& device.select_application() == M24SR::M24SR_SUCCESS,
+			"new session");
+	M24SREmulator::reset_stats();
+	check(device.read_system_file() == M24SR::M24SR_SUCCESS, "read");
+	check_stats(2, 1, 0, "read in a new session");
+	check(device.deselect() == M24SR::M24SR_SUCCESS, "deselect");
+
+	std::printf("%s\n", sFailures == 0 ? "OK" : "FAILED");
+	return sFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+/**
+ ******************************************************************************
+ * @file    VCardParseBench.cpp
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   Measure the parse time of vCard records of different sizes.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Message.h"
+#include "RecordMimeType.h"
+#include "RecordVCard.h"
+
+using namespace NDefLib;
+
+//number of times each card is parsed
+#define N_PASSES 2000
+
+/**
+ * Build a vCard 2.1 payload with nNotes folded note lines before the fields
+ * that the record keeps.
+ */
+static std::string build_card(unsigned int nNotes) {
+	std::string card = "BEGIN:VCARD\r\nVERSION:2.1\r\n";
+	char line[64];
+	for (unsigned int i = 0; i < nNotes; i++) {
+		std::snprintf(line, sizeof(line),
+				"X-NOTE%u:line %u of the note\r\n  folded part\r\n", i, i);
+		card += line;
+	}//for
+	card += "N:Doe;John\r\n"
+			"TEL;HOME:+390123456789\r\n"
+			"EMAIL;WORK:john.doe@example.com\r\n"
+			"ADR;HOME;ENCODING=QUOTED-PRINTABLE:Via Roma =\r\n1;Milano\r\n"
+			"END:VCARD\r\n";
+	return card;
+}
+
+int main() {
+	static const unsigned int nNotes[] = { 0, 16, 64, 256 };
+
+	for (unsigned int n = 0; n < sizeof(nNotes) / sizeof(nNotes[0]); n++) {
+		const std::string card = build_card(nNotes[n]);
+		RecordMimeType record("text/x-vcard", card);
+		Message msg;
+		msg.add_record(&record);
+		std::vector<uint8_t> buffer(msg.get_byte_length());
+		const uint16_t length = msg.write(&buffer[0]);
+
+		std::chrono::steady_clock::time_point start =
+				std::chrono::steady_clock::now();
+		for (unsigned int i = 0; i < N_PASSES; i++) {
+			Message parsed;
+			Message::parse_message(&buffer[2], length - 2, &parsed);
+			RecordVCard *vcard = (RecordVCard*) parsed[0];
+			if (parsed.get_N_records() != 1 || vcard == NULL
+					|| vcard->get_type() != Record::TYPE_MIME_VCARD
+					|| (*vcard)[RecordVCard::EMAIL_WORK] != "john.doe@example.com"
+					|| (*vcard)[RecordVCard::ADDRESS_HOME] != "Via Roma 1;Milano") {
+				std::printf("parse failed with %u notes\n", nNotes[n]);
+				return 1;
+			}//if
+			Message::remove_and_delete_all_record(parsed);
+		}//for
+		const double us = std::chrono::duration<double, std::micro>(
+				std::chrono::steady_clock::now() - start).count() / N_PASSES;
+
+		std::printf("%4u notes %6u bytes: %8.2f us/parse %6.1f ns/B\n",
+				nNotes[n], (unsigned int) card.size(), us,
+				us * 1000 / card.size());
+	}//for
+
+	return 0;
+}
@@ -0,0 +1,145 @@
+/**
+ ******************************************************************************
+ * @file    WifiConfFuzzer.cpp
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   Fuzz target of the RecordWifiConf WSC attribute parser.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "RecordHeader.h"
+#include "RecordWifiConf.h"
+
+using namespace NDefLib;
+
+static const std::string sWifiConfMimeType("application/vnd.wfa.wsc");
+
+/**
+ * Parse a WSC payload as a RecordWifiConf.
+ * @return the record or NULL if the payload is not valid
+ */
+static RecordWifiConf* parse_payload(const uint8_t *payload, size_t size) {
+	//MB, ME, TNF mime type, 4 bytes payload length
+	std::vector<uint8_t> buffer;
+	buffer.push_back(0xC0 | RecordHeader::Mime_media_type);
+	buffer.push_back(sWifiConfMimeType.size());
+	for (int shift = 24; shift >= 0; shift -= 8)
+		buffer.push_back((uint8_t) (size >> shift));
+	buffer.insert(buffer.end(), sWifiConfMimeType.begin(),
+			sWifiConfMimeType.end());
+	buffer.insert(buffer.end(), payload, payload + size);
+
+	RecordHeader header;
+	const uint16_t headerLength = header.load_header(buffer.data());
+	return RecordWifiConf::parse(header, buffer.data() + headerLength);
+}
+
+/**
+ * Write the record and return its payload.
+ */
+static std::vector<uint8_t> write_payload(RecordWifiConf &record) {
+	std::vector<uint8_t> buffer(record.get_byte_length());
+	if (record.write(buffer.data()) != buffer.size())
+		__builtin_trap();
+	RecordHeader header;
+	const uint16_t offset = header.load_header(buffer.data())
+			+ header.get_type_length() + header.get_id_length();
+	return std::vector<uint8_t>(buffer.begin() + offset, buffer.end());
+}
+
+/**
+ * Tell if a parsed credential is written back unchanged: the mandatory
+ * attributes are read once, and the MAC address at most once.
+ */
+static bool is_canonical(const RecordWifiConf::WifiCredential_t &credential) {
+	static const uint16_t mandatory[] = { 0x1026, 0x1045, 0x1003, 0x100F,
+			0x1027 };
+	const std::vector<uint16_t> &order = credential.attributeOrder;
+	for (size_t i = 0; i < sizeof(mandatory) / sizeof(mandatory[0]); i++) {
+		size_t n = 0;
+		for (size_t j = 0; j < order.size(); j++)
+			n += order[j] == mandatory[i];
+		if (n != 1)
+			return false;
+	}//for
+	size_t nMac = 0;
+	for (size_t j = 0; j < order.size(); j++)
+		nMac += order[j] == 0x1020;
+	return nMac <= 1;
+}
+
+std::vector<uint8_t> fuzzer_seed() {
+	static const uint8_t mac[] = { 0x00, 0x0D, 0x18, 0x01, 0x02, 0x03 };
+	static const uint8_t vendorId[] = { 0x00, 0x37, 0x2A };
+
+	RecordWifiConf::WifiCredential_t home("home", "password",
+			RecordWifiConf::AUTH_WPA2_PSK, RecordWifiConf::ENC_TYPE_AES);
+	home.set_mac_address(mac);
+	home.vendorExtensions.push_back(
+			std::string((const char*) vendorId, sizeof(vendorId)) + "v");
+	RecordWifiConf record(home);
+	record.add_credential(RecordWifiConf::WifiCredential_t("guest"));
+	record.add_vendor_extension(vendorId, "vendor");
+	return write_payload(record);
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+	//the record payload
+	if (size > 0xFFFF)
+		return 0;
+
+	RecordWifiConf *record = parse_payload(data, size);
+	if (record == NULL)
+		return 0;
+
+	//the written payload must parse to the same credentials and attributes,
+	//and be written again byte for byte
+	const std::vector<uint8_t> written = write_payload(*record);
+	bool canonical = true;
+	for (uint32_t i = 0; i < record->get_n_credentials(); i++)
+		canonical = canonical && is_canonical(record->get_credential(i));
+	//the attributes keep the read order, so a canonical payload is unchanged
+	if (canonical && written != std::vector<uint8_t>(data, data + size))
+		__builtin_trap();
+	RecordWifiConf *parsed = parse_payload(written.data(), written.size());
+	if (parsed == NULL || !(*parsed == *record)
+			|| write_payload(*parsed) != written)
+		__builtin_trap();
+
+	delete parsed;
+	delete record;
+	return 0;
+}
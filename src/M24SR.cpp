@@ -60,8 +60,6 @@
 #endif
 #define GPIO_PIN_SET (1)
 
-#define M24SR_MAX_BYTE_OPERATION_LENGHT (246)
-
 #define M24SR_MAX_I2C_ACCESS_TRY 1000
 
 /**
@@ -127,6 +125,21 @@ const uint8_t M24SR::DEFAULT_PASSWORD[16] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
   return wCrc;
 }
 
+/**
+ * @brief  This function continues a CRC 16 computation over a new chunk of data
+ * @param  Data : pointer on the data used to update the CRC16
+ * @param  Length : number of bytes of the data, can be 0
+ * @param  wCrc : CRC16 of the previous chunks
+ * @retval CRC16
+ */
+ static uint16_t M24SR_ContinueCrc(const uint8_t *Data, uint16_t Length,
+    uint16_t wCrc) {
+  while (Length--) {
+    M24SR_UpdateCrc(*Data++, &wCrc);
+  }
+  return wCrc;
+}
+
 /**
  * @brief    This function computes the CRC16 residue as defined by CRC ISO/IEC 13239
  * @param    DataIn    :  input data
@@ -161,6 +174,131 @@ const uint8_t M24SR::DEFAULT_PASSWORD[16] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
   return status;
 }
 
+/**
+ * @brief    This function computes the CRC16 residue of a response received in 3 segments
+ * @param    pHeader, NbHeaderByte : first segment of the response (PCB)
+ * @param    pData, NbDataByte : second segment of the response (data)
+ * @param    pTrailer, NbTrailerByte : last segment of the response (SW1, SW2 and CRC)
+ * @retval   Status (SW1&SW2)    :   CRC16 residue is correct
+ * @retval   M24SR_ERROR_CRC    :  CRC16 residue is false
+ */
+ static M24SR::StatusTypeDef M24SR_IsCorrectCRC16Residue(const uint8_t *pHeader,
+    uint8_t NbHeaderByte, const uint8_t *pData, uint8_t NbDataByte,
+    const uint8_t *pTrailer, uint8_t NbTrailerByte) {
+  uint16_t ResCRC = 0x6363; // ITU-V.41
+  ResCRC = M24SR_ContinueCrc(pHeader, NbHeaderByte, ResCRC);
+  ResCRC = M24SR_ContinueCrc(pData, NbDataByte, ResCRC);
+  ResCRC = M24SR_ContinueCrc(pTrailer, NbTrailerByte, ResCRC);
+
+  if (ResCRC == 0x0000 && NbTrailerByte >= UB_STATUS_OFFSET) {
+    const M24SR::StatusTypeDef status = (M24SR::StatusTypeDef) (
+        ((pTrailer[NbTrailerByte - UB_STATUS_OFFSET] << 8) & 0xFF00)
+        | (pTrailer[NbTrailerByte - LB_STATUS_OFFSET] & 0x00FF));
+    if(status==NFC_COMMAND_SUCCESS) return M24SR::M24SR_SUCCESS;
+    return status;
+  }
+
+  /* the chip can answer with a short status response: check the first bytes */
+  const uint8_t *segment[] = { pHeader, pData, pTrailer };
+  const uint8_t segmentLength[] = { NbHeaderByte, NbDataByte, NbTrailerByte };
+  uint8_t pStatus[M24SR_STATUSRESPONSE_NBBYTE];
+  uint8_t nByte = 0;
+  for (uint8_t i = 0; i < 3; i++) {
+    for (uint8_t j = 0; j < segmentLength[i] && nByte < sizeof(pStatus); j++) {
+      pStatus[nByte++] = segment[i][j];
+    }
+  }
+  if (nByte != sizeof(pStatus))
+    return M24SR::M24SR_IO_ERROR_CRC;
+
+  return M24SR_IsCorrectCRC16Residue(pStatus, sizeof(pStatus));
+}
+
+/**
+ * @brief  Compile time version of M24SR_UpdateCrc, last step of the update
+ */
+static constexpr uint16_t M24SR_MixCrc(uint8_t ch, uint16_t wCrc) {
+  return (wCrc >> 8) ^ ((uint16_t) ch << 8) ^ ((uint16_t) ch << 3)
+      ^ ((uint16_t) ch >> 4);
+}
+
+/**
+ * @brief  Compile time version of M24SR_UpdateCrc
+ * @param  ch : new byte
+ * @param  wCrc : current CRC value
+ * @retval updated CRC
+ */
+static constexpr uint16_t M24SR_UpdateCrcConst(uint8_t ch, uint16_t wCrc) {
+  return M24SR_MixCrc((uint8_t) (((uint8_t) (ch ^ (wCrc & 0x00FF)))
+      ^ (uint8_t) (((uint8_t) (ch ^ (wCrc & 0x00FF))) << 4)), wCrc);
+}
+
+static constexpr uint16_t M24SR_ComputeCrcConst(uint16_t wCrc) {
+  return wCrc;
+}
+
+/**
+ * @brief  Compile time version of M24SR_ComputeCrc
+ * @param  wCrc : initial CRC value, 0x6363 for ITU-V.41
+ * @param  ch, others : bytes used to compute the CRC16
+ * @retval CRC16
+ */
+template<typename... Bytes>
+static constexpr uint16_t M24SR_ComputeCrcConst(uint16_t wCrc, uint8_t ch,
+    Bytes... others) {
+  return M24SR_ComputeCrcConst(M24SR_UpdateCrcConst(ch, wCrc), others...);
+}
+
+/**
+ * I block built at compile time: PCB byte, APDU bytes and CRC16.
+ */
+template<uint8_t Pcb, uint8_t... Apdu>
+struct M24SR_ConstantIBlock {
+  static const uint8_t frame[sizeof...(Apdu) + 3];
+};
+
+template<uint8_t Pcb, uint8_t... Apdu>
+const uint8_t M24SR_ConstantIBlock<Pcb, Apdu...>::frame[sizeof...(Apdu) + 3] = {
+    Pcb, Apdu...,
+    GETLSB(M24SR_ComputeCrcConst(0x6363, Pcb, Apdu...)),
+    GETMSB(M24SR_ComputeCrcConst(0x6363, Pcb, Apdu...)) };
+
+/**
+ * Command that never changes: the two I blocks (block number 0 and 1) are
+ * generated at compile time, sending it does not need the command buffer.
+ */
+template<uint8_t... Apdu>
+struct M24SR_ConstantCommand {
+  static const uint8_t size = sizeof...(Apdu) + 3;
+  static const uint8_t * const frames[2];
+};
+
+template<uint8_t... Apdu>
+const uint8_t * const M24SR_ConstantCommand<Apdu...>::frames[2] = {
+    M24SR_ConstantIBlock<0x02, Apdu...>::frame,
+    M24SR_ConstantIBlock<0x03, Apdu...>::frame };
+
+/* CLA, INS, P1, P2, LC, application id (M24SR_SELECTAPPLICATION_COMMAND), LE */
+typedef M24SR_ConstantCommand<C_APDU_CLA_DEFAULT, C_APDU_SELECT_FILE, 0x04, 0x00,
+    0x07, 0xD2, 0x76, 0x00, 0x00, 0x85, 0x01, 0x01, 0x00> SelectApplicationCommand;
+/* CLA, INS, P1, P2, LC, file id */
+typedef M24SR_ConstantCommand<C_APDU_CLA_DEFAULT, C_APDU_SELECT_FILE, 0x00, 0x0C,
+    0x02, 0xE1, 0x03> SelectCCFileCommand;
+typedef M24SR_ConstantCommand<C_APDU_CLA_DEFAULT, C_APDU_SELECT_FILE, 0x00, 0x0C,
+    0x02, 0xE1, 0x01> SelectSystemFileCommand;
+typedef M24SR_ConstantCommand<C_APDU_CLA_DEFAULT, C_APDU_SELECT_FILE, 0x00, 0x0C,
+    0x02, GETMSB(NDEF_FILE_ID), GETLSB(NDEF_FILE_ID)> SelectNDEFFileCommand;
+/* CLA, INS, P1, P2 (password id), LC = 0 */
+typedef M24SR_ConstantCommand<C_APDU_CLA_DEFAULT, C_APDU_VERIFY, 0x00, READ_PWD,
+    0x00> VerifyReadPwdCommand;
+typedef M24SR_ConstantCommand<C_APDU_CLA_DEFAULT, C_APDU_VERIFY, 0x00, WRITE_PWD,
+    0x00> VerifyWritePwdCommand;
+typedef M24SR_ConstantCommand<C_APDU_CLA_DEFAULT, C_APDU_VERIFY, 0x00, I2C_PWD,
+    0x00> VerifyI2CPwdCommand;
+
+/** block number of the last I block sent */
+static uint8_t BlockNumber = 0x01;
+
 /**
  * @brief     This functions creates an I block command according to the structures CommandStructure and Command.
  * @param     Command : structure which contains the field of the different parameters
@@ -171,7 +309,6 @@ const uint8_t M24SR::DEFAULT_PASSWORD[16] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
  static void M24SR_BuildIBlockCommand(uint16_t CommandStructure, C_APDU *Command,
     uint8_t uDIDbyte, uint16_t *NbByte, uint8_t *pCommand) {
   uint16_t uCRC16;
-  static uint8_t BlockNumber = 0x01;
 
   (*NbByte) = 0;
 
@@ -257,14 +394,21 @@ M24SR::M24SR(const uint8_t address, TwoWire *I2C,gpoEventCallback eventCallback,
     GPOPin(GPOPinName),
     RFDisablePin(RFDISPinName),
     mCommunicationType(SYNC),
+    mRFGpoConfig(DEFAULT_GPO_STATUS),
+    mProductCode(0),
+    mMemorySize(0),
+    mIsSystemFileSelected(false),
+    mIsApplicationSelected(false),
+    mVerifiedPasswords(0),
     mLastCommandSend(NONE),
     mCallback(&defaultCallback),
     mComponentCallback(NULL),
     mNDefTagUtil(new NDefNfcTagM24SR(*this)),
-    mManageGPOCallback(*this),
-    mReadIDCallback(*this){
+    mSystemFileCallback(*this),
+    mProvisioningCallback(*this){
     //mNDefTagUtil(NULL){
-  memset(uM24SRbuffer, 0, 0xFF * sizeof(int8_t));
+  memset(uM24SRbuffer, 0, sizeof(uM24SRbuffer));
+  memset(mVerifiedPasswordValue, 0, sizeof(mVerifiedPasswordValue));
   uDIDbyte = 0;
     pinMode(RFDisablePin, OUTPUT);
     digitalWrite(RFDisablePin, 0);
@@ -312,6 +456,19 @@ M24SR::~M24SR(){
   return M24SR_SUCCESS;
 }
 
+/**
+ * @brief  This function sends a command precomputed at compile time
+ * @param  frames : I blocks of the command for block number 0 and 1
+ * @param  NbByte : length of the I blocks
+ * @return M24SR_SUCCESS if no errors
+ */
+ M24SR::StatusTypeDef M24SR::M24SR_SendConstantIBlock(const uint8_t * const frames[2],
+    uint8_t NbByte) {
+  /* toggle the block number */
+  BlockNumber = TOGGLE(BlockNumber);
+  return M24SR_IO_SendI2Ccommand(NbByte, frames[BlockNumber]);
+}
+
 /**
  * @brief  This function initialize the M24SR device
  * @retval None
@@ -322,13 +479,14 @@ M24SR::~M24SR(){
   StatusTypeDef status = M24SR_ForceSession();
   if(status!= M24SR_SUCCESS)
     return status;
-  //leave the gpo always up
 
-    status = M24SR_ManageI2CGPO(DEFAULT_GPO_STATUS);
-  if(status!= M24SR_SUCCESS)
-    return status;
-
-  status = M24SR_ManageRFGPO(DEFAULT_GPO_STATUS);
+  //read the system file once and leave the gpo always up,
+  //the gpo byte is written only if it is different
+  const bool isSync = mCommunicationType==M24SR::SYNC;
+  mSystemFileCallback.set_password(DEFAULT_PASSWORD);
+  status = mSystemFileCallback.start(SystemFileCallback::PROBE);
+  if(status== M24SR_SUCCESS && isSync)
+    status = mSystemFileCallback.get_status();
   if(status!= M24SR_SUCCESS)
     return status;
 
@@ -349,6 +507,7 @@ M24SR::~M24SR(){
  M24SR::StatusTypeDef M24SR::M24SR_ForceSession(void) {
   uint8_t commandBuffer[] = M24SR_KILLSESSION_COMMAND;
   M24SR::StatusTypeDef status;
+  M24SR_ResetSessionState();
   status = M24SR_IO_SendI2Ccommand(sizeof(commandBuffer), commandBuffer);
   if(status!=M24SR_SUCCESS){
     mCallback->on_session_open(this,status);
@@ -372,10 +531,13 @@ M24SR::~M24SR(){
  M24SR::StatusTypeDef M24SR::M24SR_Deselect(void) {
   uint8_t pBuffer[] = M24SR_DESELECTREQUEST_COMMAND;
   M24SR::StatusTypeDef status;
+  /* the access rights end with the session */
+  M24SR_ResetSessionState();
   /* send the request */
   status = M24SR_IO_SendI2Ccommand(sizeof(pBuffer), pBuffer);
   if(status!=M24SR_SUCCESS){
     getCallback()->on_deselect(this,status);
+    return status;
   }
 
   mLastCommandSend=DESELECT;
@@ -409,6 +571,7 @@ M24SR::StatusTypeDef M24SR::M24SR_ReceiveDeselect(void){
   uint8_t commandBuffer[] = M24SR_OPENSESSION_COMMAND;
 
   M24SR::StatusTypeDef status;
+  M24SR_ResetSessionState();
   status = M24SR_IO_SendI2Ccommand(sizeof(commandBuffer), commandBuffer);
   if(status!=M24SR_SUCCESS){
     getCallback()->on_session_open(this,status);
@@ -430,31 +593,13 @@ M24SR::StatusTypeDef M24SR::M24SR_ReceiveDeselect(void){
  */
  M24SR::StatusTypeDef M24SR::M24SR_SendSelectApplication(void) {
 
-  C_APDU command;
   M24SR::StatusTypeDef status;
-  uint8_t *pBuffer = uM24SRbuffer;
-  uint8_t pDataOut[] = M24SR_SELECTAPPLICATION_COMMAND;
-  uint8_t uLe = 0x00;
-  uint16_t uP1P2 =0x0400,  NbByte;
-
-  /* build the command */
-  command.Header.CLA = C_APDU_CLA_DEFAULT;
-  command.Header.INS = C_APDU_SELECT_FILE;
-  /* copy the offset */
-  command.Header.P1 = GETMSB(uP1P2);
-  command.Header.P2 = GETLSB(uP1P2);
-  /* copy the number of byte of the data field */
-  command.Body.LC = sizeof(pDataOut);
-  /* copy the data */
-  command.Body.pData = pDataOut;
-  /* copy the number of byte to read */
-  command.Body.LE = uLe;
-  /* build the I2C command */
-  M24SR_BuildIBlockCommand( M24SR_CMDSTRUCT_SELECTAPPLICATION, &command,
-      uDIDbyte, &NbByte, pBuffer);
+  mIsSystemFileSelected=false;
+  mIsApplicationSelected=false;
 
   /* send the request */
-  status = M24SR_IO_SendI2Ccommand(NbByte, pBuffer);
+  status = M24SR_SendConstantIBlock(SelectApplicationCommand::frames,
+      SelectApplicationCommand::size);
   if(status != M24SR_SUCCESS){
     getCallback()->on_selected_application(this,status);
     return status;
@@ -482,6 +627,7 @@ M24SR::StatusTypeDef M24SR::M24SR_ReceiveSelectApplication(void) {
     return status;
   }//else
   status= M24SR_IsCorrectCRC16Residue(pDataIn, sizeof(pDataIn));
+  mIsApplicationSelected = status==M24SR_SUCCESS;
   getCallback()->on_selected_application(this,status);
   return status;
 
@@ -494,12 +640,16 @@ M24SR::StatusTypeDef M24SR::M24SR_ReadID(uint8_t *nfc_id) {
     return M24SR_ERROR;
   }
 
-  //enable the callback for change the gpo
-  mComponentCallback = &mReadIDCallback;
-  mReadIDCallback.read_id_on(nfc_id);
+  //the product code can not change, no need to read it again
+  if(mProductCode!=0){
+    *nfc_id = mProductCode;
+    getCallback()->on_read_id(this,M24SR_SUCCESS,nfc_id);
+    return M24SR_SUCCESS;
+  }
 
-  //start the readID procedure
-  return M24SR_SendSelectApplication();
+  //the product code is read from the system file copy
+  mSystemFileCallback.read_id_on(nfc_id);
+  return mSystemFileCallback.start(SystemFileCallback::READ_ID);
 }
 
 /**
@@ -509,28 +659,12 @@ M24SR::StatusTypeDef M24SR::M24SR_ReadID(uint8_t *nfc_id) {
  * @retval Status (SW1&SW2)   if operation does not complete for another reason.
  */
  M24SR::StatusTypeDef M24SR::M24SR_SendSelectCCfile(void) {
-  C_APDU command;
   M24SR::StatusTypeDef status;
-  uint8_t *pBuffer = uM24SRbuffer;
-  uint8_t pDataOut[] = CC_FILE_ID_BYTES;
-  uint16_t uP1P2 =0x000C,
-  NbByte;
-
-  /* build the command */
-  command.Header.CLA = C_APDU_CLA_DEFAULT;
-  command.Header.INS = C_APDU_SELECT_FILE;
-  /* copy the offset */
-  command.Header.P1 = GETMSB(uP1P2);
-  command.Header.P2 = GETLSB(uP1P2);
-  /* copy the number of byte of the data field */
-  command.Body.LC = sizeof(pDataOut);
-  command.Body.pData = pDataOut;
-  /* build the I2C command */
-  M24SR_BuildIBlockCommand(M24SR_CMDSTRUCT_SELECTCCFILE, &command, uDIDbyte,
-      &NbByte, pBuffer);
+  mIsSystemFileSelected=false;
 
   /* send the request */
-  status = M24SR_IO_SendI2Ccommand(NbByte, pBuffer);
+  status = M24SR_SendConstantIBlock(SelectCCFileCommand::frames,
+      SelectCCFileCommand::size);
   if(status!=M24SR_SUCCESS){
     getCallback()->on_selected_CC_file(this,status);
     return status;
@@ -570,28 +704,12 @@ M24SR::StatusTypeDef M24SR::M24SR_ReceiveSelectCCfile(void){
  * @retval M24SR_ERROR_I2CTIMEOUT I2C timeout occurred.
  */
  M24SR::StatusTypeDef M24SR::M24SR_SendSelectSystemfile(void) {
-  C_APDU command;
-
-  uint8_t *pBuffer = uM24SRbuffer;
-  uint8_t pDataOut[] = SYSTEM_FILE_ID_BYTES;
   M24SR::StatusTypeDef status;
-  uint16_t uP1P2 =0x000C,  NbByte;
-
-  /* build the command */
-  command.Header.CLA = C_APDU_CLA_DEFAULT;
-  command.Header.INS = C_APDU_SELECT_FILE;
-  /* copy the offset */
-  command.Header.P1 = GETMSB(uP1P2);
-  command.Header.P2 = GETLSB(uP1P2);
-  /* copy the number of byte of the data field */
-  command.Body.LC = sizeof(pDataOut);
-  command.Body.pData = pDataOut;
-  /* build the I2C command */
-  M24SR_BuildIBlockCommand(M24SR_CMDSTRUCT_SELECTCCFILE, &command, uDIDbyte,
-      &NbByte, pBuffer);
+  mIsSystemFileSelected=false;
 
   /* send the request */
-  status = M24SR_IO_SendI2Ccommand(NbByte, pBuffer);
+  status = M24SR_SendConstantIBlock(SelectSystemFileCommand::frames,
+      SelectSystemFileCommand::size);
   if(status!=M24SR_SUCCESS){
     getCallback()->on_selected_system_file(this,status);
     return status;
@@ -619,6 +737,7 @@ M24SR::StatusTypeDef M24SR::M24SR_ReceiveSelectSystemfile(){
     return status;
   }//else
   status= M24SR_IsCorrectCRC16Residue(pDataIn, sizeof(pDataIn));
+  mIsSystemFileSelected = status==M24SR_SUCCESS;
   getCallback()->on_selected_system_file(this,status);
   return status;
 
@@ -626,35 +745,44 @@ M24SR::StatusTypeDef M24SR::M24SR_ReceiveSelectSystemfile(){
 
 /**
  * @brief  This function sends the SelectNDEFfile command
+ * @par If the command can not be sent, on_selected_NDEF_file is called with
+ * the error and no response is read.
  * @retval Status (SW1&SW2) Status of the operation to complete.
  * @retval M24SR_ERROR_I2CTIMEOUT I2C timeout occurred.
  */
  M24SR::StatusTypeDef M24SR::M24SR_SendSelectNDEFfile(uint16_t NDEFfileId) {
   C_APDU command;
   M24SR::StatusTypeDef status;
+  mIsSystemFileSelected=false;
   uint8_t *pBuffer = uM24SRbuffer;
   uint8_t pDataOut[] = { GETMSB(NDEFfileId), GETLSB(NDEFfileId) };
   uint16_t uP1P2 = 0x000C, NbByte;
 
-  /* build the command */
-  command.Header.CLA = C_APDU_CLA_DEFAULT;
-  command.Header.INS = C_APDU_SELECT_FILE;
-  /* copy the offset */
-  command.Header.P1 = GETMSB(uP1P2);
-  command.Header.P2 = GETLSB(uP1P2);
-  /* copy the number of byte of the data field */
-  command.Body.LC = sizeof(pDataOut);
-  command.Body.pData = pDataOut;
-  /* copy the offset */
-  /* build the I2C command */
-  M24SR_BuildIBlockCommand(M24SR_CMDSTRUCT_SELECTNDEFFILE, &command, uDIDbyte,
-      &NbByte, pBuffer);
-
-  /* send the request */
-  status = M24SR_IO_SendI2Ccommand(NbByte, pBuffer);
-  if(status!=M24SR_SUCCESS){
+  if (NDEFfileId == NDEF_FILE_ID) {
+    /* default file: the command is precomputed */
+    status = M24SR_SendConstantIBlock(SelectNDEFFileCommand::frames,
+        SelectNDEFFileCommand::size);
+  } else {
+    /* build the command */
+    command.Header.CLA = C_APDU_CLA_DEFAULT;
+    command.Header.INS = C_APDU_SELECT_FILE;
+    /* copy the offset */
+    command.Header.P1 = GETMSB(uP1P2);
+    command.Header.P2 = GETLSB(uP1P2);
+    /* copy the number of byte of the data field */
+    command.Body.LC = sizeof(pDataOut);
+    command.Body.pData = pDataOut;
+    /* build the I2C command */
+    M24SR_BuildIBlockCommand(M24SR_CMDSTRUCT_SELECTNDEFFILE, &command, uDIDbyte,
+        &NbByte, pBuffer);
 
+    /* send the request */
+    status = M24SR_IO_SendI2Ccommand(NbByte, pBuffer);
   }
+  if(status!=M24SR_SUCCESS){
+    getCallback()->on_selected_NDEF_file(this,status);
+    return status;
+  }//else
 
   mLastCommandSend=SELECT_NDEF_FILE;
 
@@ -679,6 +807,9 @@ M24SR::StatusTypeDef M24SR::M24SR_ReceiveSelectNDEFfile(){
     return status;
   }//else
   status= M24SR_IsCorrectCRC16Residue(pDataIn, sizeof(pDataIn));
+  /* the read/write access rights belong to the previous NDEF file */
+  set_password_verified(ReadPwd,NULL);
+  set_password_verified(WritePwd,NULL);
   getCallback()->on_selected_NDEF_file(this,status);
   return status;
 
@@ -739,22 +870,23 @@ M24SR::StatusTypeDef M24SR::M24SR_ReceiveReadBinary(){
   const uint16_t length = mLastCommandData.length;
   const uint16_t offset = mLastCommandData.offset;
   uint8_t *data = mLastCommandData.data;
+  uint8_t pcb;
+  uint8_t pTrailer[M24SR_STATUS_NBBYTE + M24SR_CRC_NBBYTE];
 
   mLastCommandSend=NONE;
 
-  status = M24SR_IO_ReceiveI2Cresponse (length + M24SR_STATUSRESPONSE_NBBYTE , uM24SRbuffer );
+  /* the data are stored directly in the user buffer, if the command fails
+   * its content is undefined */
+  status = M24SR_IO_ReceiveI2Cresponse(sizeof(pcb), &pcb, length, data,
+      sizeof(pTrailer), pTrailer);
   if(status!=M24SR_SUCCESS){
     getCallback()->on_read_byte(this,status,offset,data,length);
     return status;
   }
-  status = M24SR_IsCorrectCRC16Residue(uM24SRbuffer, length + M24SR_STATUSRESPONSE_NBBYTE);
-  if(status != M24SR_SUCCESS)
-    getCallback()->on_read_byte(this,status,offset,data,length);
-  else{
-    /* retrieve the data without SW1 & SW2 as provided as return value of the function */
-    memcpy(mLastCommandData.data, &uM24SRbuffer[1], length);
-    getCallback()->on_read_byte(this,status,offset,data,length);
-  }
+  status = M24SR_IsCorrectCRC16Residue(&pcb, sizeof(pcb), data, length,
+      pTrailer, sizeof(pTrailer));
+  M24SR_CheckAccessRights(status);
+  getCallback()->on_read_byte(this,status,offset,data,length);
   return status;
 
 }
@@ -799,6 +931,7 @@ M24SR::StatusTypeDef M24SR::M24SR_ReceiveReadBinary(){
   mLastCommandSend=READ;
   mLastCommandData.data=pBufferRead;
   mLastCommandData.length=NbByteToRead;
+  mLastCommandData.offset=Offset;
 
   if(mCommunicationType==M24SR::SYNC){
     return M24SR_ReceiveReadBinary();
@@ -821,26 +954,32 @@ M24SR::StatusTypeDef M24SR::M24SR_ReceiveReadBinary(){
   if(NbByteToWrite>M24SR_MAX_BYTE_OPERATION_LENGHT)
     NbByteToWrite=M24SR_MAX_BYTE_OPERATION_LENGHT;
 
-  C_APDU command;
   M24SR::StatusTypeDef status;
-  uint8_t *pBuffer = uM24SRbuffer;
-  uint16_t NbByte;
+  uint8_t pHeader[6];
+  uint8_t pTrailer[M24SR_CRC_NBBYTE];
+  uint8_t NbByte = 0;
+  uint16_t uCRC16;
 
-  /* build the command */
-  command.Header.CLA = C_APDU_CLA_DEFAULT;
-  command.Header.INS = C_APDU_UPDATE_BINARY;
+  /* the data are sent directly from the user buffer: only the header and the
+   * CRC are built here (M24SR_CMDSTRUCT_UPDATEBINARY without the data) */
+  /* toggle the block number */
+  BlockNumber = TOGGLE(BlockNumber);
+  pHeader[NbByte++] = 0x02 | BlockNumber;
+  pHeader[NbByte++] = C_APDU_CLA_DEFAULT;
+  pHeader[NbByte++] = C_APDU_UPDATE_BINARY;
   /* copy the offset */
-  command.Header.P1 = GETMSB(Offset);
-  command.Header.P2 = GETLSB(Offset);
+  pHeader[NbByte++] = GETMSB(Offset);
+  pHeader[NbByte++] = GETLSB(Offset);
   /* copy the number of byte of the data field */
-  command.Body.LC = NbByteToWrite;
-  command.Body.pData = pDataToWrite;
-  /* copy the File Id */
-  //memcpy(command.Body.pData ,pDataToWrite, NbByteToWrite );
-  M24SR_BuildIBlockCommand(M24SR_CMDSTRUCT_UPDATEBINARY, &command, uDIDbyte,
-      &NbByte, pBuffer);
+  pHeader[NbByte++] = NbByteToWrite;
 
-  status = M24SR_IO_SendI2Ccommand(NbByte, pBuffer);
+  uCRC16 = M24SR_ContinueCrc(pHeader, NbByte, 0x6363);
+  uCRC16 = M24SR_ContinueCrc(pDataToWrite, NbByteToWrite, uCRC16);
+  pTrailer[0] = GETLSB(uCRC16);
+  pTrailer[1] = GETMSB(uCRC16);
+
+  status = M24SR_IO_SendI2Ccommand(NbByte, pHeader, NbByteToWrite, pDataToWrite,
+      sizeof(pTrailer), pTrailer);
   if(status!=M24SR_SUCCESS){
     getCallback()->on_updated_binary(this,status,Offset,pDataToWrite,NbByteToWrite);
     return status;
@@ -889,6 +1028,7 @@ M24SR::StatusTypeDef M24SR::M24SR_ReceiveUpdateBinary() {
   } else { //isSBlock
     status = M24SR_IsCorrectCRC16Residue(respBuffer,
         M24SR_STATUSRESPONSE_NBBYTE);
+    M24SR_CheckAccessRights(status);
     getCallback()->on_updated_binary(this,status,offset,data,length);
   }//if else
   return status;
@@ -916,6 +1056,12 @@ M24SR::StatusTypeDef M24SR::M24SR_ReceiveUpdateBinary() {
     return M24SR_IO_ERROR_PARAMETER;
   }
 
+  /* the password is already verified in this session: skip the command */
+  if (NbPwdByte == 0x10 && is_password_verified(constToPasswordType(uPwdId),pPwd)) {
+    getCallback()->on_verified(this,M24SR_SUCCESS,constToPasswordType(uPwdId),pPwd);
+    return M24SR_SUCCESS;
+  }
+
   /* build the command */
   command.Header.CLA = C_APDU_CLA_DEFAULT;
   command.Header.INS = C_APDU_VERIFY;
@@ -931,15 +1077,27 @@ M24SR::StatusTypeDef M24SR::M24SR_ReceiveUpdateBinary() {
     /* build the I2C command */
     M24SR_BuildIBlockCommand(M24SR_CMDSTRUCT_VERIFYBINARYWITHPWD, &command,
         uDIDbyte, &NbByte, pBuffer);
+    /* send the request */
+    status = M24SR_IO_SendI2Ccommand(NbByte, pBuffer);
+  } else if (uPwdId == READ_PWD) {
+    /* without password the command is precomputed */
+    status = M24SR_SendConstantIBlock(VerifyReadPwdCommand::frames,
+        VerifyReadPwdCommand::size);
+  } else if (uPwdId == WRITE_PWD) {
+    status = M24SR_SendConstantIBlock(VerifyWritePwdCommand::frames,
+        VerifyWritePwdCommand::size);
+  } else if (uPwdId == I2C_PWD) {
+    status = M24SR_SendConstantIBlock(VerifyI2CPwdCommand::frames,
+        VerifyI2CPwdCommand::size);
   } else {
     command.Body.pData = NULL;
     /* build the I2C command */
     M24SR_BuildIBlockCommand(M24SR_CMDSTRUCT_VERIFYBINARYWOPWD, &command,
         uDIDbyte, &NbByte, pBuffer);
+    /* send the request */
+    status = M24SR_IO_SendI2Ccommand(NbByte, pBuffer);
   }
 
-  /* send the request */
-  status = M24SR_IO_SendI2Ccommand(NbByte, pBuffer);
   if(status!=M24SR_SUCCESS){
     getCallback()->on_verified(this,status,constToPasswordType(uPwdId),pPwd);
     return status;
@@ -947,6 +1105,7 @@ M24SR::StatusTypeDef M24SR::M24SR_ReceiveUpdateBinary() {
   mLastCommandSend=VERIFY;
 
   mLastCommandData.data=(uint8_t*)pPwd;
+  mLastCommandData.length=NbPwdByte;
   mLastCommandData.offset=uPwdId;
 
   if(mCommunicationType==M24SR::SYNC){
@@ -971,6 +1130,9 @@ M24SR::StatusTypeDef M24SR::M24SR_ReceiveVerify(){
     return status;
   }
   status = M24SR_IsCorrectCRC16Residue(respBuffer, M24SR_STATUSRESPONSE_NBBYTE);
+  /* a verify without password only checks if it is required */
+  if(mLastCommandData.length==0x10)
+    set_password_verified(type, status==M24SR_SUCCESS ? data : NULL);
   getCallback()->on_verified(this,status,type,data);
   return status;
 }
@@ -1045,6 +1207,10 @@ M24SR::StatusTypeDef M24SR::M24SR_ReceiveChangeReferenceData(){
   }//else
 
   status = M24SR_IsCorrectCRC16Residue(rensponseBuffer, M24SR_STATUSRESPONSE_NBBYTE);
+  M24SR_CheckAccessRights(status);
+  /* the stored value is the old password */
+  if(status==M24SR_SUCCESS)
+    set_password_verified(type,NULL);
   getCallback()->on_change_reference_data(this,status,type,data);
   return status;
 }
@@ -1112,6 +1278,7 @@ M24SR::StatusTypeDef M24SR::M24SR_ReceiveEnableVerificationRequirement(){
   }//else
 
   status = M24SR_IsCorrectCRC16Residue(rensponseBuffer, M24SR_STATUSRESPONSE_NBBYTE);
+  M24SR_CheckAccessRights(status);
   getCallback()->on_enable_verification_requirement(this,status,type);
   return status;
 }
@@ -1181,6 +1348,7 @@ M24SR::StatusTypeDef M24SR::M24SR_ReceiveDisableVerificationRequirement(){
   }//else
 
   status = M24SR_IsCorrectCRC16Residue(rensponseBuffer, M24SR_STATUSRESPONSE_NBBYTE);
+  M24SR_CheckAccessRights(status);
   getCallback()->on_disable_verification_requirement(this,status,type);
   return status;
 }
@@ -1249,6 +1417,7 @@ M24SR::StatusTypeDef M24SR::M24SR_ReceiveEnablePermanentState(){
   }//else
 
   status = M24SR_IsCorrectCRC16Residue(rensponseBuffer, M24SR_STATUSRESPONSE_NBBYTE);
+  M24SR_CheckAccessRights(status);
   getCallback()->on_enable_permanent_state(this,status,type);
   return status;
 }
@@ -1316,6 +1485,7 @@ M24SR::StatusTypeDef M24SR::M24SR_ReceiveDisablePermanentState(){
   }//else
 
   status = M24SR_IsCorrectCRC16Residue(rensponseBuffer, M24SR_STATUSRESPONSE_NBBYTE);
+  M24SR_CheckAccessRights(status);
   getCallback()->on_disable_permanent_state(this,status,type);
   return status;
 }
@@ -1414,12 +1584,10 @@ M24SR::StatusTypeDef M24SR::M24SR_ManageI2CGPO(NFC_GPO_MGMT GPO_I2Cconfig) {
   if (GPO_I2Cconfig > STATE_CONTROL) {
     return M24SR_IO_ERROR_PARAMETER;
   }
-  //enable the callback for change the gpo
-  mComponentCallback = &mManageGPOCallback;
-  mManageGPOCallback.set_new_GPO_config(true,GPO_I2Cconfig);
-
-  //start the manageGPO procedure
-  return M24SR_SendSelectApplication();
+  //change the gpo byte in the system file copy and write it if needed
+  mSystemFileCallback.set_new_GPO_config(true,GPO_I2Cconfig);
+  mSystemFileCallback.set_password(DEFAULT_PASSWORD);
+  return mSystemFileCallback.start(SystemFileCallback::MANAGE_GPO);
 }
 
 M24SR::StatusTypeDef M24SR::M24SR_ManageRFGPO(NFC_GPO_MGMT GPO_I2Cconfig) {
@@ -1427,12 +1595,9 @@ M24SR::StatusTypeDef M24SR::M24SR_ManageRFGPO(NFC_GPO_MGMT GPO_I2Cconfig) {
     return M24SR_IO_ERROR_PARAMETER;
   }
 
-  //enable the callback for change the gpo
-  mComponentCallback = &mManageGPOCallback;
-  mManageGPOCallback.set_new_GPO_config(false,GPO_I2Cconfig);
-
-  //start the manageGPO procedure
-  return M24SR_SendSelectApplication();
+  mSystemFileCallback.set_new_GPO_config(false,GPO_I2Cconfig);
+  mSystemFileCallback.set_password(DEFAULT_PASSWORD);
+  return mSystemFileCallback.start(SystemFileCallback::MANAGE_GPO);
 }
 
 M24SR::StatusTypeDef M24SR::M24SR_RFConfig(uint8_t OnOffChoice) {
@@ -1445,7 +1610,7 @@ M24SR::StatusTypeDef M24SR::M24SR_RFConfig(uint8_t OnOffChoice) {
   return M24SR_SUCCESS;
 }
 
-int M24SR::M24SR_IO_I2C_Write(uint8_t *pBuffer, uint8_t NumByteToWrite) {
+int M24SR::M24SR_IO_I2C_Write(const uint8_t *pBuffer, uint8_t NumByteToWrite) {
   dev_I2C->beginTransmission(((uint8_t)(((address) >> 1) & 0x7F)));
 
   for (int i = 0 ; i < NumByteToWrite ; i++)
@@ -1454,6 +1619,18 @@ int M24SR::M24SR_IO_I2C_Write(uint8_t *pBuffer, uint8_t NumByteToWrite) {
   return dev_I2C->endTransmission(true);
 }
 
+int M24SR::M24SR_IO_I2C_Write(const uint8_t *pHeader, uint8_t NbHeaderByte,
+    const uint8_t *pData, uint8_t NbDataByte,
+    const uint8_t *pTrailer, uint8_t NbTrailerByte) {
+  dev_I2C->beginTransmission(((uint8_t)(((address) >> 1) & 0x7F)));
+
+  dev_I2C->write(pHeader, NbHeaderByte);
+  dev_I2C->write(pData, NbDataByte);
+  dev_I2C->write(pTrailer, NbTrailerByte);
+
+  return dev_I2C->endTransmission(true);
+}
+
 int M24SR::M24SR_IO_I2C_Read(uint8_t *pBuffer, uint8_t NumByteToRead) {
   if(dev_I2C->requestFrom(((uint8_t)(((address) >> 1) & 0x7F)), (byte) NumByteToRead) == 0)
     return 1;
@@ -1468,8 +1645,25 @@ int M24SR::M24SR_IO_I2C_Read(uint8_t *pBuffer, uint8_t NumByteToRead) {
   return 0;
 }
 
+int M24SR::M24SR_IO_I2C_Read(uint8_t *pHeader, uint8_t NbHeaderByte,
+    uint8_t *pData, uint8_t NbDataByte,
+    uint8_t *pTrailer, uint8_t NbTrailerByte) {
+  const uint8_t NumByteToRead = NbHeaderByte + NbDataByte + NbTrailerByte;
+  if(dev_I2C->requestFrom(((uint8_t)(((address) >> 1) & 0x7F)), (byte) NumByteToRead) == 0)
+    return 1;
+
+  for (uint8_t i = 0; i < NbHeaderByte && dev_I2C->available(); i++)
+    pHeader[i] = dev_I2C->read();
+  for (uint8_t i = 0; i < NbDataByte && dev_I2C->available(); i++)
+    pData[i] = dev_I2C->read();
+  for (uint8_t i = 0; i < NbTrailerByte && dev_I2C->available(); i++)
+    pTrailer[i] = dev_I2C->read();
+
+  return 0;
+}
+
 M24SR::StatusTypeDef M24SR::M24SR_IO_SendI2Ccommand(uint8_t NbByte,
-    uint8_t *pBuffer) {
+    const uint8_t *pBuffer) {
 
   int nTry = 0;
   int status =1;
@@ -1479,6 +1673,27 @@ M24SR::StatusTypeDef M24SR::M24SR_IO_SendI2Ccommand(uint8_t NbByte,
   if (status == 0)
     return M24SR_SUCCESS;
 
+  /* the session state is unknown */
+  M24SR_ResetSessionState();
+  return M24SR_IO_ERROR_I2CTIMEOUT;
+
+}
+
+M24SR::StatusTypeDef M24SR::M24SR_IO_SendI2Ccommand(uint8_t NbHeaderByte,
+    const uint8_t *pHeader, uint8_t NbDataByte, const uint8_t *pData,
+    uint8_t NbTrailerByte, const uint8_t *pTrailer) {
+
+  int nTry = 0;
+  int status =1;
+  while (status != 0 && (nTry++)<M24SR_MAX_I2C_ACCESS_TRY) {
+    status = M24SR_IO_I2C_Write(pHeader, NbHeaderByte, pData, NbDataByte,
+        pTrailer, NbTrailerByte);
+  }
+  if (status == 0)
+    return M24SR_SUCCESS;
+
+  /* the session state is unknown */
+  M24SR_ResetSessionState();
   return M24SR_IO_ERROR_I2CTIMEOUT;
 
 }
@@ -1498,6 +1713,30 @@ M24SR::StatusTypeDef M24SR::M24SR_IO_ReceiveI2Cresponse(uint8_t NbByte,
   if (status == 0)
     return M24SR_SUCCESS;
 
+  /* the session state is unknown */
+  M24SR_ResetSessionState();
+  return M24SR_IO_ERROR_I2CTIMEOUT;
+}
+
+M24SR::StatusTypeDef M24SR::M24SR_IO_ReceiveI2Cresponse(uint8_t NbHeaderByte,
+    uint8_t *pHeader, uint8_t NbDataByte, uint8_t *pData,
+    uint8_t NbTrailerByte, uint8_t *pTrailer) {
+
+  int nTry = 0;
+  int status =1;
+
+  while (status != 0 && (nTry++)<M24SR_MAX_I2C_ACCESS_TRY) {
+    status = M24SR_IO_I2C_Read(pHeader, NbHeaderByte, pData, NbDataByte,
+        pTrailer, NbTrailerByte);
+    if(status != 0) {
+      delay(1); //delay required to avoid an error
+    }
+  }
+  if (status == 0)
+    return M24SR_SUCCESS;
+
+  /* the session state is unknown */
+  M24SR_ResetSessionState();
   return M24SR_IO_ERROR_I2CTIMEOUT;
 }
 
@@ -1537,6 +1776,357 @@ M24SR::StatusTypeDef M24SR::manage_event(void){
   }//switch
 }//manageInterrupt
 
+M24SR::StatusTypeDef M24SR::SystemFileCallback::start(Task_t task){
+  mTask=task;
+  mNCommands=0;
+  mPreviousCallback=mParent.mComponentCallback;
+  mParent.mComponentCallback=this;
+  return next_step(&mParent);
+}
+
+M24SR::StatusTypeDef M24SR::SystemFileCallback::next_step(M24SR *nfc){
+  SystemFile &file = mParent.mSystemFile;
+
+  if(!file.is_valid()){
+    if(!mParent.mIsSystemFileSelected)
+      return select_system_file(nfc);
+    //a single read for the whole file
+    return (StatusTypeDef) nfc->read_binary(0x0000, SystemFile::LENGTH,
+        file.mData);
+  }//if
+
+  if(mTask==MANAGE_GPO){
+    if(mI2CGpo)
+      file.set_I2C_GPO(mGpoConfig);
+    else
+      file.set_RF_GPO(mGpoConfig);
+  }else if(mTask==PROBE){
+    //both nibbles are in the same byte: a single write
+    file.set_I2C_GPO(DEFAULT_GPO_STATUS);
+    file.set_RF_GPO(DEFAULT_GPO_STATUS);
+  }//if-else
+
+  //write only if something changed
+  if(mTask!=READ_FILE && mTask!=READ_ID && file.is_changed()){
+    if(!mParent.mIsSystemFileSelected)
+      return select_system_file(nfc);
+    return nfc->verify(M24SR::I2CPwd, 0x10, mPassword);
+  }//if
+
+  onFinishCommand(nfc,M24SR_SUCCESS);
+  return M24SR_SUCCESS;
+}
+
+M24SR::StatusTypeDef M24SR::SystemFileCallback::select_system_file(M24SR *nfc){
+  if(mParent.mIsApplicationSelected)
+    return nfc->select_system_file();
+  return nfc->select_application();
+}
+
+void M24SR::SystemFileCallback::on_selected_application(M24SR *nfc,
+    StatusTypeDef status){
+  mNCommands++;
+  if(status==M24SR_SUCCESS)
+    nfc->select_system_file();
+  else
+    onFinishCommand(nfc,status);
+}
+
+void M24SR::SystemFileCallback::on_selected_system_file(M24SR *nfc,
+    StatusTypeDef status){
+  mNCommands++;
+  if(status==M24SR_SUCCESS)
+    next_step(nfc);
+  else
+    onFinishCommand(nfc,status);
+}
+
+void M24SR::SystemFileCallback::on_read_byte(M24SR *nfc,StatusTypeDef status,
+    uint16_t ,uint8_t *, uint16_t ){
+  mNCommands++;
+  if(status!=M24SR_SUCCESS)
+    return onFinishCommand(nfc,status);
+  mParent.mSystemFile.mIsValid=true;
+  mParent.mSystemFile.set_written();
+  next_step(nfc);
+}
+
+void M24SR::SystemFileCallback::on_verified(M24SR *nfc,StatusTypeDef status,
+    PasswordType_t, const uint8_t*){
+  mNCommands++;
+  if(status!=M24SR_SUCCESS)
+    return onFinishCommand(nfc,status);
+
+  //a single update from the first to the last changed byte
+  SystemFile &file = mParent.mSystemFile;
+  nfc->update_binary(file.mFirstChanged,
+      file.mLastChanged-file.mFirstChanged+1, file.mData+file.mFirstChanged);
+}
+
+void M24SR::SystemFileCallback::on_updated_binary(M24SR *nfc,
+    StatusTypeDef status,uint16_t , uint8_t*, uint16_t ){
+  mNCommands++;
+  if(status==M24SR_SUCCESS)
+    mParent.mSystemFile.set_written();
+  onFinishCommand(nfc,status);
+}
+
+void M24SR::SystemFileCallback::onFinishCommand(M24SR *nfc,
+    StatusTypeDef status){
+  mParent.mComponentCallback=mPreviousCallback;
+  mStatus=status;
+
+  //the chip content is unknown or different from the copy
+  if(status!=M24SR_SUCCESS && mTask!=READ_FILE && mTask!=READ_ID)
+    mParent.mSystemFile.invalidate();
+
+  //the capabilities are in every valid copy
+  if(mParent.mSystemFile.is_valid()){
+    mParent.mProductCode=mParent.mSystemFile.get_product_code();
+    mParent.mMemorySize=mParent.mSystemFile.get_memory_size();
+  }//if
+
+  switch(mTask){
+    case READ_FILE:
+      mParent.getCallback()->on_read_system_file(nfc,status,mParent.mSystemFile);
+      break;
+    case WRITE_FILE:
+      mParent.getCallback()->on_write_system_file(nfc,status,mParent.mSystemFile);
+      break;
+    case READ_ID:
+      if(status==M24SR_SUCCESS)
+        *mIdPtr=mParent.mSystemFile.get_product_code();
+      mParent.getCallback()->on_read_id(nfc,status,mIdPtr);
+      break;
+    case MANAGE_GPO:
+      if(status==M24SR_SUCCESS){
+        if(!mI2CGpo)
+          mParent.mRFGpoConfig = mGpoConfig;
+        else if (mGpoConfig == I2C_ANSWER_READY)
+          mParent.mCommunicationType = ASYNC;
+        else
+          mParent.mCommunicationType = SYNC;
+      }//if
+      if(mI2CGpo)
+        mParent.getCallback()->on_manage_I2C_GPO(nfc,status,mGpoConfig);
+      else
+        mParent.getCallback()->on_manage_RF_GPO(nfc,status,mGpoConfig);
+      break;
+    case PROBE:
+      //same state left by manage_I2C_GPO and manage_RF_GPO
+      if(status==M24SR_SUCCESS){
+        mParent.mRFGpoConfig = DEFAULT_GPO_STATUS;
+        mParent.mCommunicationType = SYNC;
+      }//if
+      break;
+  }//switch
+}//onFinishCommand
+
+M24SR::StatusTypeDef M24SR::provision(const ProvisioningProfile_t &profile){
+  //the NDEF file image starts with its length
+  if(profile.ndefFile!=NULL && (profile.ndefFileLength<2 ||
+      ((profile.ndefFile[0]<<8) | profile.ndefFile[1])!=profile.ndefFileLength-2)){
+    return M24SR_IO_ERROR_PARAMETER;
+  }
+  if((profile.setI2CGpo && profile.i2cGpo>STATE_CONTROL) ||
+      (profile.setRFGpo && profile.rfGpo>STATE_CONTROL)){
+    return M24SR_IO_ERROR_PARAMETER;
+  }
+
+  //the procedure can change the communication mode
+  const bool isSync = mCommunicationType==M24SR::SYNC;
+  const StatusTypeDef status = mProvisioningCallback.start(profile);
+  if(isSync){
+    return mProvisioningCallback.get_report().status;
+  }
+  return status;
+}
+
+M24SR::ProvisioningCallback::ProvisioningCallback(M24SR &parent):
+    mParent(parent),mStartTime(0),mNDEFFileOffset(0),mGpoWritten(false){
+  memset(&mProfile,0,sizeof(mProfile));
+  mReport.status=M24SR_SUCCESS;
+  mReport.nCommands=0;
+  mReport.elapsedUs=0;
+}
+
+M24SR::StatusTypeDef M24SR::ProvisioningCallback::start(
+    const ProvisioningProfile_t &profile){
+  mProfile=profile;
+  if(mProfile.ndefFileId==0)
+    mProfile.ndefFileId=NDEF_FILE_ID;
+  if(mProfile.i2cPassword==NULL)
+    mProfile.i2cPassword=M24SR::DEFAULT_PASSWORD;
+  if(mProfile.writePassword==NULL)
+    mProfile.writePassword=M24SR::DEFAULT_PASSWORD;
+
+  mReport.status=M24SR_SUCCESS;
+  mReport.nCommands=0;
+  mReport.elapsedUs=0;
+  mNDEFFileOffset=0;
+  mGpoWritten=false;
+  mStartTime=micros();
+
+  mParent.mComponentCallback=this;
+  return mParent.get_session();
+}
+
+void M24SR::ProvisioningCallback::on_session_open(M24SR *nfc,StatusTypeDef status){
+  mReport.nCommands++;
+  if(status!=M24SR_SUCCESS){
+    //no session to close
+    mReport.status=status;
+    return onFinishCommand(nfc);
+  }
+  nfc->select_application();
+}
+
+void M24SR::ProvisioningCallback::on_selected_application(M24SR *nfc,
+    StatusTypeDef status){
+  mReport.nCommands++;
+  if(status!=M24SR_SUCCESS)
+    return abort(nfc,status);
+  if(need_NDEF_file())
+    nfc->select_NDEF_file(mProfile.ndefFileId);
+  else
+    change_GPO(nfc);
+}
+
+void M24SR::ProvisioningCallback::on_selected_NDEF_file(M24SR *nfc,
+    StatusTypeDef status){
+  mReport.nCommands++;
+  if(status!=M24SR_SUCCESS)
+    return abort(nfc,status);
+  //a single verify grants the write access for the file and the passwords
+  nfc->verify(M24SR::WritePwd,0x10,mProfile.writePassword);
+}
+
+void M24SR::ProvisioningCallback::on_verified(M24SR *nfc,StatusTypeDef status,
+    PasswordType_t ,const uint8_t *){
+  mReport.nCommands++;
+  if(status!=M24SR_SUCCESS)
+    return abort(nfc,status);
+  write_NDEF_file(nfc);
+}
+
+void M24SR::ProvisioningCallback::write_NDEF_file(M24SR *nfc){
+  if(mProfile.ndefFile!=NULL && mNDEFFileOffset<mProfile.ndefFileLength){
+    uint16_t nByte = mProfile.ndefFileLength-mNDEFFileOffset;
+    if(nByte>M24SR_MAX_BYTE_OPERATION_LENGHT)
+      nByte=M24SR_MAX_BYTE_OPERATION_LENGHT;
+    nfc->update_binary(mNDEFFileOffset,(uint8_t)nByte,
+        (uint8_t*)mProfile.ndefFile+mNDEFFileOffset);
+    return;
+  }//if
+  if(mProfile.newReadPassword!=NULL)
+    change_password(nfc,M24SR::ReadPwd);
+  else
+    change_password(nfc,M24SR::WritePwd);
+}
+
+void M24SR::ProvisioningCallback::on_updated_binary(M24SR *nfc,
+    StatusTypeDef status,uint16_t ,uint8_t *,uint16_t nWriteByte){
+  mReport.nCommands++;
+  if(status!=M24SR_SUCCESS)
+    return abort(nfc,status);
+  mNDEFFileOffset+=nWriteByte;
+  write_NDEF_file(nfc);
+}
+
+void M24SR::ProvisioningCallback::change_password(M24SR *nfc,
+    PasswordType_t type){
+  const uint8_t *newPassword = type==M24SR::ReadPwd ?
+      mProfile.newReadPassword : mProfile.newWritePassword;
+  if(newPassword!=NULL)
+    nfc->change_reference_data(type,newPassword);
+  else
+    change_GPO(nfc);
+}
+
+void M24SR::ProvisioningCallback::on_change_reference_data(M24SR *nfc,
+    StatusTypeDef status,PasswordType_t type,uint8_t *){
+  mReport.nCommands++;
+  if(status!=M24SR_SUCCESS)
+    return abort(nfc,status);
+  nfc->enable_verification_requirement(type);
+}
+
+void M24SR::ProvisioningCallback::on_enable_verification_requirement(
+    M24SR *nfc,StatusTypeDef status,PasswordType_t type){
+  mReport.nCommands++;
+  if(status!=M24SR_SUCCESS)
+    return abort(nfc,status);
+  if(type==M24SR::ReadPwd)
+    change_password(nfc,M24SR::WritePwd);
+  else
+    change_GPO(nfc);
+}
+
+void M24SR::ProvisioningCallback::change_GPO(M24SR *nfc){
+  if(mProfile.setI2CGpo || mProfile.setRFGpo)
+    nfc->read_system_file();
+  else
+    nfc->deselect();
+}
+
+void M24SR::ProvisioningCallback::on_read_system_file(M24SR *nfc,
+    StatusTypeDef status,const SystemFile &){
+  mReport.nCommands+=mParent.mSystemFileCallback.get_n_commands();
+  if(status!=M24SR_SUCCESS)
+    return abort(nfc,status);
+  //both configurations are in the same byte: a single write, if it changes
+  if(mProfile.setI2CGpo)
+    mParent.mSystemFile.set_I2C_GPO(mProfile.i2cGpo);
+  if(mProfile.setRFGpo)
+    mParent.mSystemFile.set_RF_GPO(mProfile.rfGpo);
+  nfc->write_system_file(mProfile.i2cPassword);
+}
+
+void M24SR::ProvisioningCallback::on_write_system_file(M24SR *nfc,
+    StatusTypeDef status,const SystemFile &){
+  mReport.nCommands+=mParent.mSystemFileCallback.get_n_commands();
+  if(status!=M24SR_SUCCESS)
+    return abort(nfc,status);
+  mGpoWritten=true;
+  nfc->deselect();
+}
+
+void M24SR::ProvisioningCallback::abort(M24SR *nfc,StatusTypeDef status){
+  mReport.status=status;
+  nfc->deselect();
+}
+
+void M24SR::ProvisioningCallback::on_deselect(M24SR *nfc,StatusTypeDef status){
+  mReport.nCommands++;
+  //keep the status of the command that stopped the procedure
+  if(mReport.status==M24SR_SUCCESS)
+    mReport.status=status;
+  onFinishCommand(nfc);
+}
+
+void M24SR::ProvisioningCallback::onFinishCommand(M24SR *nfc){
+  mReport.elapsedUs=(uint32_t)(micros()-mStartTime);
+  mParent.mComponentCallback=NULL;
+
+  //the tag content changed, also if the write stopped in the middle
+  if(mNDEFFileOffset!=0)
+    mParent.mNDefTagUtil->invalidate_read_cache();
+
+  if(mGpoWritten){
+    if(mProfile.setRFGpo)
+      mParent.mRFGpoConfig=mProfile.rfGpo;
+    if(mProfile.setI2CGpo){
+      if(mProfile.i2cGpo==I2C_ANSWER_READY){
+        mParent.mCommunicationType=ASYNC;
+      }else{
+        mParent.mCommunicationType=SYNC;
+      }//if-else
+    }//if
+  }//if
+
+  mParent.mCallback->on_provisioned(nfc,mReport.status,mReport);
+}//onFinishCommand
+
 NDefLib::NDefNfcTag* M24SR::get_NDef_tag(){
     return mNDefTagUtil;
 }
@@ -1588,7 +2178,7 @@ void M24SR::readTxt(char text_read[])
       for(int i =0 ;i<(int)nRecords ;i++) {
         if(msg[i]->get_type()== NDefLib::Record::TYPE_TEXT) {
           NDefLib::RecordText *rTxt = (NDefLib::RecordText *)msg[i];
-          strcpy(text_read, rTxt->get_text().c_str());
+          strcpy(text_read, rTxt->get_text_utf8().c_str());
         }
       }
 
@@ -1612,7 +2202,13 @@ bool M24SR::writeUri(const char *text)
   if(tag->open_session()) {
     //create the NDef message and record
     NDefLib::Message msg;
-    NDefLib::RecordURI rUri(NDefLib::RecordURI::HTTP_WWW, text);
+    //use the longest known prefix of the text, http://www. if it has no scheme
+    NDefLib::RecordURI::knowUriId_t uriId =
+      NDefLib::RecordURI::find_uri_prefix(text, strlen(text));
+    if(uriId == NDefLib::RecordURI::UNKNOWN) {
+      uriId = NDefLib::RecordURI::HTTP_WWW;
+    }
+    NDefLib::RecordURI rUri(uriId, text);
     msg.add_record(&rUri);
     //write the tag
     if(tag->write(msg)) {
@@ -1934,5 +2530,23 @@ void M24SR::readMime(char *read_type, uint8_t *read_data, uint8_t *read_dataLeng
   }
 }
 
+bool M24SR::writeNdefFile(const uint8_t *file, uint16_t length)
+{
+  bool success = false;
+
+  //retrieve the NdefLib interface
+  NDefLib::NDefNfcTag *tag = this->get_NDef_tag();
+
+  //open the i2c session with the nfc chip
+  if(tag->open_session()) {
+    //the file already contains the encoded message
+    success = tag->write_ndef_file(file, length);
+
+    //close the i2c session
+    tag->close_session();
+  }
+  return success;
+}
+
 
 /******************* (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -140,6 +140,186 @@ public:
 	 */
 	static const NFC_GPO_MGMT DEFAULT_GPO_STATUS=HIGH_IMPEDANCE;
 
+	/**
+	 * Configuration written by {@link M24SR#provision}, a NULL or false field
+	 * leaves the device setting unchanged.
+	 * @par The passwords must have a length of 16 chars.
+	 */
+	typedef struct{
+		const uint8_t *i2cPassword;      //!< I2C password needed to change the gpo configuration, NULL for DEFAULT_PASSWORD
+		const uint8_t *writePassword;    //!< current write password, NULL for DEFAULT_PASSWORD
+		const uint8_t *newReadPassword;  //!< password to request before reading the tag
+		const uint8_t *newWritePassword; //!< password to request before writing the tag
+		bool setI2CGpo;                  //!< true to change the gpo configuration for the I2C session
+		NFC_GPO_MGMT i2cGpo;             //!< new gpo configuration for the I2C session
+		bool setRFGpo;                   //!< true to change the gpo configuration for the RF session
+		NFC_GPO_MGMT rfGpo;              //!< new gpo configuration for the RF session
+		uint16_t ndefFileId;             //!< NDEF file to write and protect, 0 for NDEF_FILE_ID
+		const uint8_t *ndefFile;         //!< NDEF file image to write, 2 length bytes included
+		uint16_t ndefFileLength;         //!< NDEF file image length
+	}ProvisioningProfile_t;
+
+	/**
+	 * Result of {@link M24SR#provision}.
+	 */
+	typedef struct{
+		StatusTypeDef status; //!< M24SR_SUCCESS or the status of the first failed command
+		uint16_t nCommands;   //!< number of commands sent to the chip
+		uint32_t elapsedUs;   //!< time from the session request to the deselect answer, in microseconds
+	}ProvisioningReport_t;
+
+	/**
+	 * Copy of the system file, read once for each I2C session.
+	 * @par The setters only change the copy, {@link M24SR#write_system_file}
+	 * writes the changed bytes in the chip.
+	 */
+	class SystemFile{
+
+	public:
+
+		/** system file size in bytes */
+		static const uint8_t LENGTH = 18;
+
+		/** UID size in bytes */
+		static const uint8_t UID_LENGTH = 7;
+
+		SystemFile(){
+			invalidate();
+		}
+
+		/**
+		 * @return true if the copy was read in the current session
+		 */
+		bool is_valid() const{
+			return mIsValid;
+		}
+
+		/**
+		 * @return true if a setter changed the copy after the last read/write
+		 */
+		bool is_changed() const{
+			return mFirstChanged<=mLastChanged;
+		}
+
+		/** @return system file length field */
+		uint16_t get_length() const{
+			return (mData[0x00]<<8) | mData[0x01];
+		}
+
+		/** @return I2C protection: 0 not protected, 1 protected by the I2C password */
+		uint8_t get_I2C_protect() const{
+			return mData[0x02];
+		}
+
+		/** @return I2C watchdog setting */
+		uint8_t get_I2C_watchdog() const{
+			return mData[0x03];
+		}
+
+		/** @return gpo configuration for the I2C session */
+		NFC_GPO_MGMT get_I2C_GPO() const{
+			return (NFC_GPO_MGMT)(mData[0x04] & 0x0F);
+		}
+
+		/** @return gpo configuration for the RF session */
+		NFC_GPO_MGMT get_RF_GPO() const{
+			return (NFC_GPO_MGMT)((mData[0x04]>>4) & 0x07);
+		}
+
+		/** @return RF enable byte */
+		uint8_t get_RF_enable() const{
+			return mData[0x06];
+		}
+
+		/** @return number of NDEF files */
+		uint8_t get_NDEF_file_number() const{
+			return mData[0x07];
+		}
+
+		/** @return chip UID, UID_LENGTH bytes */
+		const uint8_t* get_UID() const{
+			return mData+0x08;
+		}
+
+		/** @return NDEF memory size in bytes */
+		uint16_t get_memory_size() const{
+			return (mData[0x0F]<<8) | mData[0x10];
+		}
+
+		/** @return product code */
+		uint8_t get_product_code() const{
+			return mData[0x11];
+		}
+
+		void set_I2C_protect(uint8_t protect){
+			set_byte(0x02,protect);
+		}
+
+		void set_I2C_watchdog(uint8_t watchdog){
+			set_byte(0x03,watchdog);
+		}
+
+		void set_I2C_GPO(NFC_GPO_MGMT config){
+			set_byte(0x04,(mData[0x04] & 0xF0) | (uint8_t)config);
+		}
+
+		void set_RF_GPO(NFC_GPO_MGMT config){
+			set_byte(0x04,(mData[0x04] & 0x0F) | (((uint8_t)config)<<4));
+		}
+
+		void set_RF_enable(uint8_t enable){
+			set_byte(0x06,enable);
+		}
+
+	private:
+
+		friend class M24SR;
+
+		/**
+		 * Change a byte, remembering the changed range.
+		 * @param offset Byte offset.
+		 * @param value New value.
+		 */
+		void set_byte(uint8_t offset,uint8_t value){
+			if(mData[offset]==value)
+				return;
+			mData[offset]=value;
+			if(offset<mFirstChanged)
+				mFirstChanged=offset;
+			if(offset>mLastChanged)
+				mLastChanged=offset;
+		}
+
+		/**
+		 * Mark the copy as equal to the chip content.
+		 */
+		void set_written(){
+			mFirstChanged=LENGTH;
+			mLastChanged=0;
+		}
+
+		/**
+		 * Discard the copy.
+		 */
+		void invalidate(){
+			memset(mData,0,sizeof(mData));
+			mIsValid=false;
+			set_written();
+		}
+
+		/** system file content */
+		uint8_t mData[LENGTH];
+
+		/** true if mData was read in the current session */
+		bool mIsValid;
+
+		/** first changed byte, LENGTH if nothing is changed */
+		uint8_t mFirstChanged;
+
+		/** last changed byte */
+		uint8_t mLastChanged;
+	};
+
 
 	/**
 	 * Function that will be called when an interrupt is fired,
@@ -159,7 +339,8 @@ public:
 	void readTxt(char text_read[]);
 
 	/**
-	 * This function write a URI in the NFC flag with hardcoded HTTP_WWW type
+	 * This function write a URI in the NFC flag, the known prefix of the URI is
+	 * abbreviated and HTTP_WWW is used if the URI doesn't start with a known prefix
 	 */
 	bool writeUri(const char *text);
 
@@ -213,6 +394,12 @@ public:
 	 */
 	void readMime(char *read_type, uint8_t *read_data, uint8_t *read_dataLength);
 
+	/**
+	 * This function writes a complete NDEF file image in the NFC flag, the
+	 * image can be built at compile time with NDefLib::StaticMessage
+	 */
+	bool writeNdefFile(const uint8_t *file, uint16_t length);
+
 	/**
 	 * Object that contains all the callbacks fired by this class, each command has its own callback.
 	 * The callback default implementation is an empty function.
@@ -384,6 +571,27 @@ public:
 				(void)nfc; (void)status;
 			}
 
+			/** called when read_system_file completes
+			 * @see M24SR#read_system_file */
+			virtual void on_read_system_file(M24SR *nfc, StatusTypeDef status,
+					const SystemFile &file){
+				(void)nfc; (void)status; (void)file;
+			}
+
+			/** called when write_system_file completes
+			 * @see M24SR#write_system_file */
+			virtual void on_write_system_file(M24SR *nfc, StatusTypeDef status,
+					const SystemFile &file){
+				(void)nfc; (void)status; (void)file;
+			}
+
+			/** called when provision completes
+			 * @see M24SR#provision */
+			virtual void on_provisioned(M24SR *nfc, StatusTypeDef status,
+					const ProvisioningReport_t &report){
+				(void)nfc; (void)status; (void)report;
+			}
+
 			virtual ~Callbacks(){};
 		};
 
@@ -567,6 +775,30 @@ public:
 				(NFC_GPO_MGMT) GPO_RFconfig);
 	}
 
+	/**
+	 * @return GPO configuration for the RF session set with manage_RF_GPO,
+	 * DEFAULT_GPO_STATUS if it was never changed
+	 */
+	NFC_GPO_MGMT get_RF_GPO_config() const {
+		return mRFGpoConfig;
+	}
+
+	/**
+	 * @return product code read by begin or read_id: I_AM_M24SR,
+	 * I_AM_M24SR_AUTOMOTIVE, 0 if the chip was never probed
+	 */
+	uint8_t get_product_code() const {
+		return mProductCode;
+	}
+
+	/**
+	 * @return NDEF memory size in bytes read by begin or read_id,
+	 * 0 if the chip was never probed
+	 */
+	uint16_t get_memory_size() const {
+		return mMemorySize;
+	}
+
 
 	/**
 	 * @brief  This function enables or disables the RF communication.
@@ -595,6 +827,48 @@ public:
 	 */
 	StatusTypeDef manage_event();
 
+	/**
+	 * Read the system file, the copy is read from the chip once for each
+	 * session.
+	 * @return M24SR_SUCCESS if no errors
+	 */
+	StatusTypeDef read_system_file(){
+		return mSystemFileCallback.start(SystemFileCallback::READ_FILE);
+	}
+
+	/**
+	 * Write the bytes changed in the system file copy, with a single verify
+	 * and a single update.
+	 * @par The system file must be read before changing it.
+	 * @param pI2CPassword I2C password, 16 chars, NULL for DEFAULT_PASSWORD.
+	 * @return M24SR_SUCCESS if no errors
+	 */
+	StatusTypeDef write_system_file(const uint8_t *pI2CPassword=NULL){
+		if(!mSystemFile.is_valid())
+			return M24SR_IO_ERROR_PARAMETER;
+		mSystemFileCallback.set_password(pI2CPassword);
+		return mSystemFileCallback.start(SystemFileCallback::WRITE_FILE);
+	}
+
+	/**
+	 * Get the copy of the system file.
+	 * @return system file copy, valid only after read_system_file
+	 */
+	SystemFile& get_system_file(){
+		return mSystemFile;
+	}
+
+	/**
+	 * Forget the passwords verified in the current session, the next verify
+	 * will be sent to the chip.
+	 * @par The passwords are also forgotten when the session is closed or
+	 * lost, and when a command fails.
+	 */
+	void invalidate_verified_passwords(){
+		mVerifiedPasswords=0;
+		memset(mVerifiedPasswordValue,0,sizeof(mVerifiedPasswordValue));
+	}
+
 	/**
 	 * Change the function to call when a command ends.
 	 * @param commandCallback Object containing the callback, if NULL it will use empty callback
@@ -737,6 +1011,27 @@ public:
 	}
 
 
+	/**
+	 * Configure the device with a single I2C session: write the NDEF file,
+	 * enable the read/write passwords and change the gpo configuration.
+	 * @par Each file is selected once and each password is verified once, the
+	 * steps not requested by the profile are skipped. Use it for production
+	 * lines, where the same profile is written on each device.
+	 * @par The NDefLib session must be closed, the profile buffers must be
+	 * valid until the on_provisioned callback.
+	 * @param profile Configuration to write.
+	 * @return M24SR_SUCCESS if no errors, in sync mode the status of the whole
+	 * procedure
+	 */
+	StatusTypeDef provision(const ProvisioningProfile_t &profile);
+
+	/**
+	 * @return commands sent and time spent by the last call to provision
+	 */
+	const ProvisioningReport_t& get_provisioning_report() const{
+		return mProvisioningCallback.get_report();
+	}
+
 	/**
 	 * Get an implementation of NDefNfcTag to use the library NDefLib.
 	 * @return an object of type NdefNfcTag
@@ -810,13 +1105,37 @@ protected:
 	StatusTypeDef M24SR_RFConfig(uint8_t OnOffChoice);
 	StatusTypeDef M24SR_SendFWTExtension(uint8_t FWTbyte);
 
+	/**
+	 * Send a command whose I blocks are precomputed at compile time.
+	 * @param frames I blocks of the command for block number 0 and 1.
+	 * @param NbByte Length of the I blocks.
+	 * @return M24SR_SUCCESS if no errors
+	 */
+	StatusTypeDef M24SR_SendConstantIBlock(const uint8_t * const frames[2],
+			uint8_t NbByte);
+
 	/**
 	 * Send a command to the component.
 	 * @param pBuffer Buffer containing the command.
 	 * @param NumByteToWrite Length of the command.
 	 * @return 0 if no errors
 	 */
-	int M24SR_IO_I2C_Write(uint8_t *pBuffer, uint8_t NumByteToWrite);
+	int M24SR_IO_I2C_Write(const uint8_t *pBuffer, uint8_t NumByteToWrite);
+
+	/**
+	 * Send a command made of 3 segments in a single I2C transaction,
+	 * the segments are not copied.
+	 * @param pHeader First segment.
+	 * @param NbHeaderByte Length of the first segment.
+	 * @param pData Second segment.
+	 * @param NbDataByte Length of the second segment.
+	 * @param pTrailer Third segment.
+	 * @param NbTrailerByte Length of the third segment.
+	 * @return 0 if no errors
+	 */
+	int M24SR_IO_I2C_Write(const uint8_t *pHeader, uint8_t NbHeaderByte,
+			const uint8_t *pData, uint8_t NbDataByte,
+			const uint8_t *pTrailer, uint8_t NbTrailerByte);
 
 	/**
 	 * Read a command response.
@@ -826,13 +1145,43 @@ protected:
 	 */
 	int M24SR_IO_I2C_Read(uint8_t *pBuffer, uint8_t NumByteToRead);
 
+	/**
+	 * Read a command response split in 3 segments (header, data, trailer),
+	 * each segment is stored in its own buffer.
+	 * @param pHeader Buffer to store the header into.
+	 * @param NbHeaderByte Length of the header.
+	 * @param pData Buffer to store the data into.
+	 * @param NbDataByte Length of the data.
+	 * @param pTrailer Buffer to store the trailer into.
+	 * @param NbTrailerByte Length of the trailer.
+	 * @return 0 if no errors
+	 */
+	int M24SR_IO_I2C_Read(uint8_t *pHeader, uint8_t NbHeaderByte,
+			uint8_t *pData, uint8_t NbDataByte,
+			uint8_t *pTrailer, uint8_t NbTrailerByte);
+
 	/**
 	 * Send a command to the component.
 	 * @param NbByte Length of the command.
 	 * @param pBuffer Buffer containing the command.
 	 * @return M24SR_SUCCESS if no errors
 	 */
-	StatusTypeDef M24SR_IO_SendI2Ccommand(uint8_t NbByte, uint8_t *pBuffer);
+	StatusTypeDef M24SR_IO_SendI2Ccommand(uint8_t NbByte, const uint8_t *pBuffer);
+
+	/**
+	 * Send a command split in 3 segments (header, data, CRC) without
+	 * copying them into a single buffer.
+	 * @param NbHeaderByte Length of the header.
+	 * @param pHeader Command header.
+	 * @param NbDataByte Length of the data.
+	 * @param pData Command data.
+	 * @param NbTrailerByte Length of the trailer.
+	 * @param pTrailer Command trailer.
+	 * @return M24SR_SUCCESS if no errors
+	 */
+	StatusTypeDef M24SR_IO_SendI2Ccommand(uint8_t NbHeaderByte,
+			const uint8_t *pHeader, uint8_t NbDataByte, const uint8_t *pData,
+			uint8_t NbTrailerByte, const uint8_t *pTrailer);
 
 	/**
 	 * Read a command response.
@@ -843,6 +1192,21 @@ protected:
 	StatusTypeDef M24SR_IO_ReceiveI2Cresponse(uint8_t NbByte,
 			uint8_t *pBuffer);
 
+	/**
+	 * Read a command response split in 3 segments (header, data, trailer)
+	 * without using an intermediate buffer.
+	 * @param NbHeaderByte Length of the header.
+	 * @param pHeader Buffer to store the header into.
+	 * @param NbDataByte Length of the data.
+	 * @param pData Buffer to store the data into.
+	 * @param NbTrailerByte Length of the trailer.
+	 * @param pTrailer Buffer to store the trailer into.
+	 * @return M24SR_SUCCESS if no errors
+	 */
+	StatusTypeDef M24SR_IO_ReceiveI2Cresponse(uint8_t NbHeaderByte,
+			uint8_t *pHeader, uint8_t NbDataByte, uint8_t *pData,
+			uint8_t NbTrailerByte, uint8_t *pTrailer);
+
 	/**
 	 * Do an active polling on the I2C bus until the answer is ready.
 	 * @return M24SR_SUCCESS if no errors
@@ -893,7 +1257,7 @@ protected:
 	/**
 	 * Buffer used to build the command to send to the chip.
 	 */
-	uint8_t uM24SRbuffer[0xFF];//max command length is 255
+	uint8_t uM24SRbuffer[M24SR_MAX_COMMAND_NBBYTE];
 
 	/**
 	 * ???
@@ -946,6 +1310,97 @@ protected:
 	 */
 	M24SR_communication_t mCommunicationType;
 
+	/**
+	 * GPO configuration for the RF session
+	 */
+	NFC_GPO_MGMT mRFGpoConfig;
+
+	/**
+	 * Product code, 0 until the system file is read
+	 */
+	uint8_t mProductCode;
+
+	/**
+	 * NDEF memory size, 0 until the system file is read
+	 */
+	uint16_t mMemorySize;
+
+	/**
+	 * Copy of the system file
+	 */
+	SystemFile mSystemFile;
+
+	/**
+	 * True if the system file is the selected file
+	 */
+	bool mIsSystemFileSelected;
+
+	/**
+	 * True if the NDEF application is selected in the current session
+	 */
+	bool mIsApplicationSelected;
+
+	/**
+	 * Forget the state of the closed or lost session: verified passwords,
+	 * system file copy and selected application and file.
+	 */
+	void M24SR_ResetSessionState(){
+		invalidate_verified_passwords();
+		mSystemFile.invalidate();
+		mIsSystemFileSelected=false;
+		mIsApplicationSelected=false;
+	}
+
+	/**
+	 * Passwords verified in the current session, one bit for each PasswordType_t
+	 */
+	uint8_t mVerifiedPasswords;
+
+	/**
+	 * Value of the verified passwords, indexed by PasswordType_t
+	 */
+	uint8_t mVerifiedPasswordValue[3][16];
+
+	/**
+	 * Check if a password was already verified in the current session.
+	 * @param type Password type.
+	 * @param pPwd Password value, 16 bytes.
+	 * @return true if the same password is verified
+	 */
+	bool is_password_verified(PasswordType_t type,const uint8_t *pPwd) const{
+		return (mVerifiedPasswords & (1<<type))!=0 &&
+				memcmp(mVerifiedPasswordValue[type],pPwd,
+						sizeof(mVerifiedPasswordValue[type]))==0;
+	}
+
+	/**
+	 * Store or forget a verified password.
+	 * @param type Password type.
+	 * @param pPwd Verified password, NULL to forget it.
+	 */
+	void set_password_verified(PasswordType_t type,const uint8_t *pPwd){
+		if(pPwd!=NULL){
+			mVerifiedPasswords |= (1<<type);
+			memcpy(mVerifiedPasswordValue[type],pPwd,
+					sizeof(mVerifiedPasswordValue[type]));
+		}else{
+			mVerifiedPasswords &= ~(1<<type);
+			memset(mVerifiedPasswordValue[type],0,
+					sizeof(mVerifiedPasswordValue[type]));
+		}//if-else
+	}
+
+	/**
+	 * Forget the verified passwords if a command status shows that the
+	 * access rights are lost.
+	 * @param status Command status.
+	 */
+	void M24SR_CheckAccessRights(StatusTypeDef status){
+		if(status==M24SR_SECURITY_UNSATISFIED || status==M24SR_PASSWORD_REQUIRED ||
+				status==M24SR_RF_SESSION_KILLED)
+			invalidate_verified_passwords();
+	}
+
 	/**
 	 * Last pending command
 	 */
@@ -1291,27 +1746,58 @@ private:
 
 
 	/**
-	 * Object with the callback used to send a ManageGPO command.
+	 * Object with the callback used to read or change the system file.
 	 * This class is equivalent to calling the methods:
 	 * <ul>
-	 *   <li> SelectedApplication </li>
-	 *   <li> SelectSystemfile </li>
-	 *   <li> ReadBinar: read the old value </li>
-	 *   <li> onVerified </li>
-	 *   <li> onUpdatedBinary: write the new value</li>
+	 *   <li> SelectedApplication, SelectSystemfile: if the system file is not
+	 *   selected, the application only if it is not selected </li>
+	 *   <li> ReadBinary: the whole file, if the copy is not valid </li>
+	 *   <li> Verify(i2c), UpdateBinary: the changed bytes, when writing </li>
 	 * </ul>
+	 * It is used by read/write_system_file, read_id, the ManageGPO commands,
+	 * the startup probe and the provisioning procedure.
+	 * @par The component callback active when the procedure starts is restored
+	 * at the end, so another procedure can run this one as a step.
 	 */
-	class ManageGPOCallback : public Callbacks{
+	class SystemFileCallback : public Callbacks{
 
 	public:
 
+		/**
+		 * Procedure to run.
+		 */
+		typedef enum{
+			READ_FILE, //!< read the system file
+			WRITE_FILE,//!< write the changed bytes
+			READ_ID,   //!< read the product code
+			MANAGE_GPO,//!< change the I2C or RF gpo configuration
+			PROBE      //!< read the chip capabilities and set both gpo to DEFAULT_GPO_STATUS
+		}Task_t;
+
 		/**
 		 * Build the chain of callbacks.
-		 * @param parent Parent component to run the command on.
+		 * @param parent Component to run the commands on.
+		 */
+		SystemFileCallback(M24SR &parent):mParent(parent),mTask(READ_FILE),
+				mPassword(M24SR::DEFAULT_PASSWORD),mIdPtr(NULL),
+				mGpoConfig(HIGH_IMPEDANCE),mI2CGpo(true),mStatus(M24SR_SUCCESS),
+				mPreviousCallback(NULL),mNCommands(0){}
+
+		/**
+		 * Set the I2C password used to write the file.
+		 * @param pwd I2C password, NULL for DEFAULT_PASSWORD.
 		 */
-		ManageGPOCallback(M24SR &parent):mParent(parent),
-				mGpoConfig(HIGH_IMPEDANCE),mReadGpoConfig(0),mI2CGpo(true){}
+		void set_password(const uint8_t *pwd){
+			mPassword = pwd!=NULL ? pwd : M24SR::DEFAULT_PASSWORD;
+		}
 
+		/**
+		 * Set the variable containing the product code.
+		 * @param idPtr
+		 */
+		void read_id_on(uint8_t *idPtr){
+			mIdPtr=idPtr;
+		}
 
 		/**
 		 * Command parameters.
@@ -1323,168 +1809,230 @@ private:
 			mI2CGpo =i2cGpo;
 		}
 
-		virtual void on_selected_application(M24SR *nfc,StatusTypeDef status){
-			if(status==M24SR_SUCCESS)
-				nfc->select_system_file();
-			else
-				onFinishCommand(nfc,status);
-		}
-
-		virtual void on_selected_system_file(M24SR *nfc,StatusTypeDef status){
-			if(status==M24SR_SUCCESS)
-				nfc->read_binary(0x0004, 0x01, &mReadGpoConfig);
-			else
-				onFinishCommand(nfc,status);
-		}
+		/**
+		 * Start a procedure.
+		 * @param task Procedure to run.
+		 * @return status of the first command, M24SR_SUCCESS if no command is needed
+		 */
+		StatusTypeDef start(Task_t task);
 
-		virtual void on_read_byte(M24SR *nfc,StatusTypeDef status,
-				uint16_t,uint8_t*, uint16_t ){
-			if(status==M24SR_SUCCESS)
-				nfc->verify(M24SR::I2CPwd, 0x10, M24SR::DEFAULT_PASSWORD);
-			else
-				onFinishCommand(nfc,status);
+		/**
+		 * @return status of the last finished procedure
+		 */
+		StatusTypeDef get_status() const{
+			return mStatus;
 		}
 
-		virtual void on_verified(M24SR *nfc,StatusTypeDef status,PasswordType_t, const uint8_t*){
-			if(status!=M24SR_SUCCESS)
-				return onFinishCommand(nfc,status);
-
-			if(mI2CGpo)
-				mReadGpoConfig = (mReadGpoConfig & 0xF0) | (uint8_t)mGpoConfig;
-			else
-				mReadGpoConfig = (mReadGpoConfig & 0x0F) | (((uint8_t)mGpoConfig)<<4);
-
-			nfc->update_binary(0x0004, 0x01, &mReadGpoConfig);
+		/**
+		 * @return number of commands sent by the last procedure
+		 */
+		uint16_t get_n_commands() const{
+			return mNCommands;
 		}
 
+		virtual void on_selected_application(M24SR *nfc,StatusTypeDef status);
+		virtual void on_selected_system_file(M24SR *nfc,StatusTypeDef status);
+		virtual void on_read_byte(M24SR *nfc,StatusTypeDef status,
+				uint16_t offset,uint8_t *readByte, uint16_t nReadByte);
+		virtual void on_verified(M24SR *nfc,StatusTypeDef status,
+				PasswordType_t uPwdId,const uint8_t *pwd);
 		virtual void on_updated_binary(M24SR *nfc,StatusTypeDef status,
-				uint16_t , uint8_t*, uint16_t ){
-
-			if(status==M24SR_SUCCESS){
-				if (mGpoConfig == I2C_ANSWER_READY){
-					mParent.mCommunicationType = ASYNC;
-				}else{
-					mParent.mCommunicationType = SYNC;
-				}//if-else
-			}//status
-			onFinishCommand(nfc,status);
-		}
+				uint16_t offset,uint8_t *writeByte,uint16_t nWriteByte);
 
 	private:
 
+		/**
+		 * Send the next command needed by the task.
+		 * @param nfc Object where send the commands.
+		 * @return status of the command
+		 */
+		StatusTypeDef next_step(M24SR *nfc);
+
+		/**
+		 * Select the system file, selecting the application first if needed.
+		 * @param nfc Object where send the commands.
+		 * @return status of the command
+		 */
+		StatusTypeDef select_system_file(M24SR *nfc);
+
 		/**
 		 * Remove the private callback and call the user callback.
 		 * @param nfc Object where the command was send to.
 		 * @param status Command status.
 		 */
-		void onFinishCommand(M24SR *nfc,StatusTypeDef status){
-			mParent.mComponentCallback=NULL;
-			if(mI2CGpo){
-				mParent.mCallback->on_manage_I2C_GPO(nfc,status,mGpoConfig);
-			}else{
-				mParent.mCallback->on_manage_RF_GPO(nfc,status,mGpoConfig);
-			}//if-else
-		}//onFinishCommand
+		void onFinishCommand(M24SR *nfc,StatusTypeDef status);
 
 		/**
 		 * Component where send the commands
 		 */
 		M24SR &mParent;
 
+		/** running procedure */
+		Task_t mTask;
+
+		/** I2C password used to write the file */
+		const uint8_t *mPassword;
+
+		/** pointer to read id */
+		uint8_t *mIdPtr;
+
 		/** new gpo function that this class has to write */
 		NFC_GPO_MGMT mGpoConfig;
 
-		/**
-		 * variable where storeing the read gpo configuration
-		 */
-		uint8_t mReadGpoConfig;
-
 		/**
 		 * true to change the i2c gpo, false to change the rf gpo
 		 */
 		bool mI2CGpo;
 
+		/** status of the last finished procedure */
+		StatusTypeDef mStatus;
+
+		/** component callback to restore at the end of the procedure */
+		Callbacks *mPreviousCallback;
+
+		/** number of commands sent by the running procedure */
+		uint16_t mNCommands;
 	};
 
 	/**
-	 * Object containing the callback chain needed to change the gpo function
+	 * Object containing the callback chain needed to read and write the system file
 	 */
-	ManageGPOCallback mManageGPOCallback;
-
+	SystemFileCallback mSystemFileCallback;
+	friend class SystemFileCallback;
 
 	/**
-	 * Object with the callback used to read the component ID
+	 * Object with the callback used to provision the device.
 	 * This class is equivalent to calling the methods:
 	 * <ul>
-	 *   <li> SelectedApplication </li>
-	 *   <li> SelectSystemfile </li>
-	 *   <li> read_binary </li>
+	 *   <li> GetSession </li>
+	 *   <li> SelectApplication </li>
+	 *   <li> SelectNDEFfile, Verify(write), UpdateBinary: write the NDEF file </li>
+	 *   <li> ChangeReferenceData, EnableVerificationRequirement: read and write password </li>
+	 *   <li> read_system_file, write_system_file: both gpo configurations,
+	 *   written only if they change </li>
+	 *   <li> Deselect </li>
 	 * </ul>
+	 * The steps that the profile doesn't need are skipped.
 	 */
-	class ReadIDCallback : public Callbacks{
+	class ProvisioningCallback : public Callbacks{
 
 	public:
 
 		/**
 		 * Build the chain of callbacks.
-		 * @param parent object where to send the command to.
+		 * @param parent Component to provision.
 		 */
-		ReadIDCallback(M24SR &parent):mParent(parent),mIdPtr(NULL){}
+		ProvisioningCallback(M24SR &parent);
 
 		/**
-		 * Set the variable containing the result
-		 * @param idPtr
+		 * Open the session and start the procedure.
+		 * @param profile Configuration to write.
+		 * @return status of the first command
 		 */
-		void read_id_on(uint8_t *idPtr){
-			mIdPtr=idPtr;
+		StatusTypeDef start(const ProvisioningProfile_t &profile);
+
+		/**
+		 * @return result of the last procedure
+		 */
+		const ProvisioningReport_t& get_report() const{
+			return mReport;
 		}
 
-		virtual void on_selected_application(M24SR *nfc,StatusTypeDef status){
-			if(status==M24SR_SUCCESS){
-				nfc->select_system_file();
-			}else
-				onFinishCommand(nfc,status);
+		virtual void on_session_open(M24SR *nfc,StatusTypeDef status);
+		virtual void on_selected_application(M24SR *nfc,StatusTypeDef status);
+		virtual void on_selected_NDEF_file(M24SR *nfc,StatusTypeDef status);
+		virtual void on_updated_binary(M24SR *nfc,StatusTypeDef status,
+				uint16_t offset,uint8_t *writeByte,uint16_t nWriteByte);
+		virtual void on_verified(M24SR *nfc,StatusTypeDef status,
+				PasswordType_t uPwdId,const uint8_t *pwd);
+		virtual void on_change_reference_data(M24SR *nfc,StatusTypeDef status,
+				PasswordType_t type,uint8_t *data);
+		virtual void on_enable_verification_requirement(M24SR *nfc,
+				StatusTypeDef status,PasswordType_t type);
+		virtual void on_read_system_file(M24SR *nfc,StatusTypeDef status,
+				const SystemFile &file);
+		virtual void on_write_system_file(M24SR *nfc,StatusTypeDef status,
+				const SystemFile &file);
+		virtual void on_deselect(M24SR *nfc,StatusTypeDef status);
 
-		}
+	private:
 
-		virtual void on_selected_system_file(M24SR *nfc,StatusTypeDef status){
-			if(status==M24SR_SUCCESS){
-				nfc->read_binary(0x0011, 0x01, mIdPtr);
-			}else
-				onFinishCommand(nfc,status);
+		/**
+		 * @return true if the NDEF file must be written or protected
+		 */
+		bool need_NDEF_file() const{
+			return mProfile.ndefFile!=NULL || mProfile.newReadPassword!=NULL ||
+					mProfile.newWritePassword!=NULL;
 		}
 
-		virtual void on_read_byte(M24SR *nfc,StatusTypeDef status,
-			uint16_t ,uint8_t *, uint16_t ){
-			onFinishCommand(nfc,status);
-		}
+		/**
+		 * Write the next part of the NDEF file, or go to the password step.
+		 * @param nfc Object where send the commands.
+		 */
+		void write_NDEF_file(M24SR *nfc);
 
-	private:
+		/**
+		 * Change the next password, or go to the gpo step.
+		 * @param nfc Object where send the commands.
+		 * @param type Password to change.
+		 */
+		void change_password(M24SR *nfc,PasswordType_t type);
 
 		/**
-		 * Remove the private callback and call the user onReadId function.
-		 * @param nfc Object where the command was send.
-		 * @param status Command status.
+		 * Change the gpo configuration, or close the session.
+		 * @param nfc Object where send the commands.
 		 */
-		void onFinishCommand(M24SR *nfc,StatusTypeDef status){
-			mParent.mComponentCallback=NULL;
-			mParent.getCallback()->on_read_id(nfc,status,mIdPtr);
-		}
+		void change_GPO(M24SR *nfc);
 
-		M24SR& mParent;
+		/**
+		 * Stop the procedure and close the session.
+		 * @param nfc Object where send the commands.
+		 * @param status Status of the failed command.
+		 */
+		void abort(M24SR *nfc,StatusTypeDef status);
 
 		/**
-		 * pointer to read id
+		 * Remove the private callback and call the user callback.
+		 * @param nfc Object where the commands were send.
 		 */
-		uint8_t *mIdPtr;
-	};
+		void onFinishCommand(M24SR *nfc);
+
+		/**
+		 * Component to provision
+		 */
+		M24SR &mParent;
+
+		/**
+		 * Configuration to write
+		 */
+		ProvisioningProfile_t mProfile;
 
+		/**
+		 * Result of the procedure
+		 */
+		ProvisioningReport_t mReport;
+
+		/**
+		 * Time when the procedure started, in microseconds
+		 */
+		uint32_t mStartTime;
+
+		/**
+		 * Number of NDEF file bytes already written
+		 */
+		uint16_t mNDEFFileOffset;
+
+		/**
+		 * True if the gpo configuration is the one in the profile
+		 */
+		bool mGpoWritten;
+	};
 
 	/**
-	 * Object containing the callback chain needed to read the component id
+	 * Object containing the callback chain needed to provision the device
 	 */
-	ReadIDCallback mReadIDCallback;
-	friend class ReadIDCallback;
+	ProvisioningCallback mProvisioningCallback;
+	friend class ProvisioningCallback;
 
 	/**
 	 * Convert a generic enum to the value used by the M24SR chip.
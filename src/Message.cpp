@@ -42,41 +42,59 @@
 #include "RecordAAR.h"
 #include "RecordMimeType.h"
 #include "RecordURI.h"
+#include "RecordHandover.h"
+#include "RecordSmartPoster.h"
+#include "RecordExternal.h"
+#include "RecordAbsoluteUri.h"
+#include "UnknownRecord.h"
 
 namespace NDefLib {
 
-uint16_t Message::get_byte_length() const {
-	uint16_t lenght = 2; //length size
+uint32_t Message::get_byte_length() const {
+	uint32_t lenght = 2; //length size
 
 	if (mRecords.size() == 0)
 		return lenght + EmptyRecord().get_byte_length();
 
-	std::vector<Record*>::const_iterator it = mRecords.begin();
-	const std::vector<Record*>::const_iterator end = mRecords.end();
-
-	for (; it != end; ++it) {
-		lenght += (*it)->get_byte_length();
+	const uint32_t nRecord = mRecords.size();
+	for (uint32_t i = 0; i < nRecord; i++) {
+		lenght += mRecords[i].record->get_byte_length();
 	} //for
 
 	return lenght;
 } //getByteLenght
 
+const RecordText* Message::get_text_record(const std::string &language) const {
+	const RecordText *bestText = NULL;
+	const uint32_t nRecord = mRecords.size();
+	for (uint32_t i = 0; i < nRecord; i++) {
+		if (mRecords[i].record->get_type() != Record::TYPE_TEXT)
+			continue;
+		const RecordText *text = (const RecordText*) mRecords[i].record;
+		const RecordText::LanguageMatch_t match = text->match_language(language);
+		if (match == RecordText::LANGUAGE_EXACT_MATCH)
+			return text;
+		if (match == RecordText::LANGUAGE_PRIMARY_MATCH && bestText == NULL)
+			bestText = text;
+	} //for
+	return bestText;
+}
+
 uint16_t Message::write(uint8_t *buffer) const {
 
-	const uint16_t length = get_byte_length() - 2;
-	uint16_t offset = 0;
-	buffer[offset++] = (uint8_t) ((length & 0xFF00) >> 8);
-	buffer[offset++] = (uint8_t) ((length & 0x00FF));
+	//the length is known after writing the records, leave space for it
+	uint16_t offset = 2;
 
 	const uint32_t nRecord = mRecords.size();
 
 	if (mRecords.size() == 0) {
 		offset += EmptyRecord().write(buffer + offset);
+		write_length(buffer, offset - 2);
 		return offset;
 	} //else
 
 	for (uint32_t i = 0; i < nRecord; i++) {
-		Record *r = mRecords[i];
+		Record *r = mRecords[i].record;
 
 		r->set_as_middle_record();
 		if (i == 0)
@@ -87,30 +105,121 @@ uint16_t Message::write(uint8_t *buffer) const {
 		offset += r->write(buffer + offset);
 	} //for
 
+	write_length(buffer, offset - 2);
 	return offset;
 } //write
 
-void Message::parse_message(const uint8_t * const rawNdefFile,
-		const uint16_t length, Message *msg) {
+Message::ParseStatus_t Message::validate_message(
+		const uint8_t * const rawNdefFile, const uint16_t length) {
+	uint32_t offset = 0;
+	bool inChunk = false;
+
+	RecordHeader header;
+	while (offset < length) {
+		//check that header, type, id and payload are inside the buffer
+		if (header.load_header(rawNdefFile + offset, length - offset) == 0)
+			return PARSE_RECORD_OUT_OF_BOUNDS;
+		if (header.get_MB() != (offset == 0))
+			return PARSE_INVALID_MESSAGE_BEGIN;
+
+		const RecordHeader::TypeNameFormat_t tnf = header.get_FNT();
+		const uint8_t typeLength = header.get_type_length();
+		switch (tnf) {
+		case RecordHeader::Empty:
+			if (typeLength != 0 || header.get_id_length() != 0
+					|| header.get_payload_length() != 0)
+				return PARSE_INVALID_TYPE_NAME_FORMAT;
+			break;
+		case RecordHeader::NFC_well_known:
+		case RecordHeader::Mime_media_type:
+		case RecordHeader::Absolute_URI:
+		case RecordHeader::NFC_external:
+			if (typeLength == 0)
+				return PARSE_INVALID_TYPE_NAME_FORMAT;
+			break;
+		case RecordHeader::Unknown:
+		case RecordHeader::Unchanged:
+			if (typeLength != 0)
+				return PARSE_INVALID_TYPE_NAME_FORMAT;
+			break;
+		default:
+			return PARSE_INVALID_TYPE_NAME_FORMAT;
+		} //switch
+
+		//the chunks after the first one have TNF unchanged and no id
+		if (inChunk != (tnf == RecordHeader::Unchanged)
+				|| (inChunk && header.get_IL()))
+			return PARSE_INVALID_CHUNK;
+		inChunk = header.get_CF();
+
+		offset += header.get_record_length();
+		if (header.get_ME())
+			return inChunk ? PARSE_INVALID_CHUNK : PARSE_OK;
+	} //while
+
+	//an empty buffer is an empty message
+	return length == 0 ? PARSE_OK : PARSE_MISSING_MESSAGE_END;
+}
+
+Message::ParseStatus_t Message::parse_message(
+		const uint8_t * const rawNdefFile, const uint16_t length, Message *msg) {
+	return parse_message(rawNdefFile, length, msg, false);
+}
+
+Message::ParseStatus_t Message::parse_message(
+		const uint8_t * const rawNdefFile, const uint16_t length, Message *msg,
+		const bool isOwned) {
+	const ParseStatus_t status = validate_message(rawNdefFile, length);
+	if (status != PARSE_OK)
+		return status;
+
 	uint16_t offset = 0;
 	Record *r;
 
 	RecordHeader header;
-	do {
+	while (offset < length) {
 		const uint8_t headerLenght = header.load_header(rawNdefFile + offset);
-		r = RecordText::parse(header, rawNdefFile + offset + headerLenght);
+		r = NULL;
+		//the typed parsers read a whole record and would drop the chunk flag:
+		//keep each chunk as it is
+		if (header.get_CF() || header.get_FNT() == RecordHeader::Unchanged)
+			r = UnknownRecord::parse(header,
+					rawNdefFile + offset + headerLenght);
+		if (r == NULL)
+			r = RecordText::parse(header, rawNdefFile + offset + headerLenght);
 		if (r == NULL)
 			r = RecordAAR::parse(header, rawNdefFile + offset + headerLenght);
+		if (r == NULL)
+			r = RecordExternal::parse(header,
+					rawNdefFile + offset + headerLenght);
+		if (r == NULL)
+			r = RecordAbsoluteUri::parse(header,
+					rawNdefFile + offset + headerLenght);
 		if (r == NULL)
 			r = RecordMimeType::parse(header,
 					rawNdefFile + offset + headerLenght);
+		if (r == NULL)
+			r = RecordHandover::parse(header,
+					rawNdefFile + offset + headerLenght);
+		if (r == NULL)
+			r = RecordSmartPoster::parse(header,
+					rawNdefFile + offset + headerLenght);
 		if (r == NULL)
 			r = RecordURI::parse(header, rawNdefFile + offset + headerLenght);
+		//keep the record as it is, so it is written back without changes
+		if (r == NULL)
+			r = UnknownRecord::parse(header,
+					rawNdefFile + offset + headerLenght);
+
+		r->load_id(header, rawNdefFile + offset + headerLenght);
 
 		offset += header.get_record_length();
-		msg->add_record(r);
-	} while (offset < length);
+		msg->mRecords.push_back(r, isOwned);
+		if (header.get_ME())
+			break;
+	} //while
 
+	return PARSE_OK;
 }
 
 void Message::remove_and_delete_all_record(Message &msg){
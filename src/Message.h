@@ -38,34 +38,135 @@
 #ifndef NDEFLIB_MESSAGE_H_
 #define NDEFLIB_MESSAGE_H_
 
-#include <algorithm>
+#include <memory>
 #include <vector>
 
 #include "Record.h"
+#include "RecordList.h"
 
 namespace NDefLib {
 
+class RecordText;
+
 /**
  * Class containing a list of {@link Record}
+ * @par A record added as a pointer is not owned by the message, a record added
+ * as a std::unique_ptr is deleted with the message.
+ * @par A copy of a message doesn't own any record.
  */
 class Message {
 public:
 
+	/**
+	 * Result of the message validation.
+	 */
+	typedef enum {
+		PARSE_OK,                    //!< valid message
+		PARSE_RECORD_OUT_OF_BOUNDS,  //!< a record header, type, id or payload exceeds the buffer
+		PARSE_INVALID_MESSAGE_BEGIN, //!< the MB flag is not set only in the first record
+		PARSE_MISSING_MESSAGE_END,   //!< the buffer ends before a record with the ME flag
+		PARSE_INVALID_TYPE_NAME_FORMAT, //!< reserved TNF, or record type not compatible with the TNF
+		PARSE_INVALID_CHUNK          //!< chunked record not valid or not terminated
+	} ParseStatus_t;
+
+	/**
+	 * Max number of bytes of a NDEF file, 2 length bytes included: the CC file
+	 * stores the NDEF file size in 16 bits.
+	 */
+	static const uint32_t MAX_BYTE_LENGTH = 0xFFFF;
+
+	Message() {
+	}
+
+	/**
+	 * Copy the record list of another message, the copy doesn't own any record.
+	 * @par The records owned by the other message are shared: the copy must not
+	 * be used after the other message deletes them.
+	 * @param other Message to copy.
+	 */
+	Message(const Message &other) {
+		copy_records(other);
+	}
+
+	/**
+	 * Delete the records owned by this message and copy the record list of
+	 * another message, the copy doesn't own any record.
+	 * @par The records owned by the other message are shared: this message must
+	 * not be used after the other message deletes them.
+	 * @param other Message to copy.
+	 */
+	Message& operator=(const Message &other) {
+		if (this != &other) {
+			delete_owned_records();
+			mRecords.clear();
+			copy_records(other);
+		}
+		return *this;
+	}
+
+	/**
+	 * Move the records of another message in this one, the other message is
+	 * left empty.
+	 * @param other Message to move.
+	 */
+	Message(Message &&other) :
+			mRecords(std::move(other.mRecords)) {
+	}
+
+	/**
+	 * Delete the records owned by this message and move the records of another
+	 * message in this one, the other message is left empty.
+	 * @param other Message to move.
+	 */
+	Message& operator=(Message &&other) {
+		if (this != &other) {
+			delete_owned_records();
+			mRecords = std::move(other.mRecords);
+		}
+		return *this;
+	}
+
 	/**
 	 * Add a ndef record to this message.
-	 * @param r Record to add
+	 * @param r Record to add, the caller keeps the ownership.
 	 */
 	void add_record(Record *r) {
-		mRecords.push_back(r);
+		mRecords.push_back(r, false);
+	}
+
+	/**
+	 * Add a ndef record to this message, the record will be deleted with the message.
+	 * @param r Record to add.
+	 */
+	void add_record(std::unique_ptr<Record> r) {
+		if (mRecords.push_back(r.get(), true))
+			r.release();
 	}
 
 	/**
 	 * Remove a ndef record to this message
+	 * @par If the record is owned by the message it is deleted.
 	 * @param r record to remove
 	 */
 	void remove_record(Record *r){
-		mRecords.erase( std::remove( mRecords.begin(), mRecords.end(), r ),
-			 mRecords.end() );
+		uint32_t i = 0;
+		while (i < mRecords.size()) {
+			if (mRecords[i].record != r) {
+				i++;
+				continue;
+			}
+			if (mRecords[i].isOwned)
+				delete r;
+			mRecords.erase(i);
+		} //while
+	}
+
+	/**
+	 * Remove all the records, the ones owned by the message are deleted.
+	 */
+	void clear() {
+		delete_owned_records();
+		mRecords.clear();
 	}
 
 
@@ -74,7 +175,9 @@ public:
 	 * @param addList List of records to add.
 	 */
 	void add_records(const std::vector<Record*> &addList) {
-		mRecords.insert(mRecords.end(), addList.begin(), addList.end());
+		const uint32_t nRecords = addList.size();
+		for (uint32_t i = 0; i < nRecords; i++)
+			mRecords.push_back(addList[i], false);
 	}
 
 	/**
@@ -85,7 +188,7 @@ public:
 	Record* operator[](const uint32_t index)const{
 		if (index >= mRecords.size())
 			return NULL;
-		return mRecords[index];
+		return mRecords[index].record;
 	}
 
 	/**
@@ -96,11 +199,22 @@ public:
 		return mRecords.size();
 	}
 
+	/**
+	 * Search the text record in a language, a message can contain the same
+	 * text in different languages.
+	 * @par If there isn't a record with the same language code, the first
+	 * record with the same primary language is returned ("en-US" for "en").
+	 * @param language Language code.
+	 * @return text record, NULL if there is not a text in that language
+	 */
+	const RecordText* get_text_record(const std::string &language) const;
+
 	/**
 	 * Length in bytes needed to write this message.
-	 * @return number of bytes needed to write this message
+	 * @return number of bytes needed to write this message, 2 length bytes included
+	 * @par A value bigger than MAX_BYTE_LENGTH can not be written in a NDEF file.
 	 */
-	uint16_t get_byte_length() const;
+	uint32_t get_byte_length() const;
 
 	/**
 	 * Write message in the provided buffer
@@ -110,30 +224,120 @@ public:
 	 */
 	uint16_t write(uint8_t *buffer) const;
 
+	/**
+	 * Write message in the provided buffer, if it fits inside it.
+	 * @par The first 2 bytes contain the NDEF message length.
+	 * @param[out] buffer Buffer the message must be written into.
+	 * @param bufferLength Buffer size in bytes.
+	 * @return number of bytes written, 0 if the message is longer than the buffer
+	 * or than MAX_BYTE_LENGTH, in this case the buffer is not changed
+	 */
+	uint16_t write(uint8_t *buffer, const uint32_t bufferLength) const {
+		const uint32_t length = get_byte_length();
+		if (length > bufferLength || length > MAX_BYTE_LENGTH)
+			return 0;
+		return write(buffer);
+	}
+
+	/**
+	 * Check that all the records are inside the buffer and that the record flags
+	 * are consistent, without building the records.
+	 * @par Message buffer must NOT contain the buffer length in the first two bytes.
+	 * @param buffer Buffer containing the message record.
+	 * @param bufferLength Buffer length.
+	 * @return PARSE_OK if the message can be parsed, otherwise the first error found
+	 * @par The data after the record with the ME flag are ignored.
+	 */
+	static ParseStatus_t validate_message(const uint8_t * const buffer,
+			const uint16_t bufferLength);
+
 	/**
 	 * Create a set of records from a raw buffer adding them to a message object.
 	 * @par Message buffer must NOT contain the buffer length in the first two bytes.
+	 * @par The buffer is validated with {@link Message#validate_message} before
+	 * building any record, so it can come from an untrusted tag.
 	 * @param buffer Buffer containing the message record.
 	 * @param bufferLength Buffer length.
 	 * @param[in,out] Message message that will contain the new records.
+	 * @return PARSE_OK if the records are added to the message, otherwise the
+	 * validation error, in this case the message is not changed
 	 */
-	static void parse_message(const uint8_t * const buffer,
+	static ParseStatus_t parse_message(const uint8_t * const buffer,
 			const uint16_t bufferLength, Message *message);
 
+	/**
+	 * Create a set of records from a raw buffer adding them to this message,
+	 * the new records are owned by the message.
+	 * @par Message buffer must NOT contain the buffer length in the first two bytes.
+	 * @param buffer Buffer containing the message record.
+	 * @param bufferLength Buffer length.
+	 * @return PARSE_OK if the records are added to the message, otherwise the
+	 * validation error, in this case the message is not changed
+	 */
+	ParseStatus_t parse_message(const uint8_t * const buffer,
+			const uint16_t bufferLength) {
+		return parse_message(buffer, bufferLength, this, true);
+	}
+
 	/**
 	 * Remove all the recrods from the mesasge and delete it
+	 * @par Owned and not owned records are deleted.
 	 * @param msg Message with the records to delete
 	 */
 	static void remove_and_delete_all_record(Message &msg);
 
 	virtual ~Message() {
+		delete_owned_records();
 	}
 
 private:
+
+	/**
+	 * Add the records parsed from a raw buffer to a message.
+	 * @param buffer Buffer containing the message record.
+	 * @param bufferLength Buffer length.
+	 * @param[in,out] message Message that will contain the new records.
+	 * @param isOwned True if the message must delete the new records.
+	 * @return PARSE_OK if the records are added to the message
+	 */
+	static ParseStatus_t parse_message(const uint8_t * const buffer,
+			const uint16_t bufferLength, Message *message, const bool isOwned);
+
+	/**
+	 * Delete the records owned by this message, the list is not changed.
+	 */
+	void delete_owned_records() {
+		const uint32_t nRecords = mRecords.size();
+		for (uint32_t i = 0; i < nRecords; i++) {
+			if (mRecords[i].isOwned)
+				delete mRecords[i].record;
+		} //for
+	}
+
+	/**
+	 * Add the records of another message, without taking their ownership.
+	 * @param other Message to copy.
+	 */
+	void copy_records(const Message &other) {
+		const uint32_t nRecords = other.mRecords.size();
+		for (uint32_t i = 0; i < nRecords; i++)
+			mRecords.push_back(other.mRecords[i].record, false);
+	}
+
+	/**
+	 * Write the message length in the first 2 bytes of the buffer.
+	 * @param[out] buffer Buffer where the message is written.
+	 * @param length Message length, without the 2 length bytes.
+	 */
+	static void write_length(uint8_t *buffer, const uint16_t length) {
+		buffer[0] = (uint8_t) ((length & 0xFF00) >> 8);
+		buffer[1] = (uint8_t) ((length & 0x00FF));
+	}
+
 	/**
 	 * List of records contained by this message.
 	 */
-	std::vector<Record*> mRecords;
+	RecordList mRecords;
 };
 
 } /* namespace NDefLib */
@@ -90,6 +90,15 @@ public:
 				(void)tag;(void)success; (void)msg;
 			};
 
+			/**
+			 * Called when a NDEF file image is written.
+			 * @param tag Tag where the file is written.
+			 * @param success True if the operation has success.
+			 */
+			virtual void on_ndef_file_write(NDefNfcTag *tag,bool success){
+				(void)tag;(void)success;
+			};
+
 
 			/**
 			 * Called when a session is closed.
@@ -164,7 +173,13 @@ public:
 			return false;
 		}
 
-		const uint16_t length = msg.get_byte_length();
+		//fail before writing anything if the message doesn't fit in the tag
+		const uint32_t length = msg.get_byte_length();
+		if(length>get_max_ndef_file_size()){
+			mCallBack->on_message_write(this,false,msg);
+			return false;
+		}
+
 		uint8_t *buffer = new uint8_t[length];
 		if(buffer==NULL){ //impossible to allocate the buffer
 			mCallBack->on_message_write(this,false,msg);
@@ -179,6 +194,37 @@ public:
 		return writeByte(buffer, length,0,NDefNfcTag::onWriteMessageCallback,&mCallBackStatus);
 	}
 
+	/**
+	 * Write a NDEF file image, for example built with {@link StaticMessage}.
+	 * @par This call will delete the previous message.
+	 * @param file File content: the message length (2 bytes, most significant
+	 * byte first) followed by the message records.
+	 * @param length Number of bytes of the file.
+	 * @return true if success
+	 * @par The buffer is not copied, it must be valid until on_ndef_file_write is called.
+	 */
+	virtual bool write_ndef_file(const uint8_t *file, uint16_t length) {
+		//the message length must match the file length
+		if(!is_session_open() || length<2 || length>get_max_ndef_file_size() ||
+				((((uint16_t) file[0]) << 8) | file[1])!=length-2){
+			mCallBack->on_ndef_file_write(this,false);
+			return false;
+		}
+
+		mCallBackStatus.callOwner=this;
+		mCallBackStatus.msg=NULL;
+
+		return writeByte(file, length,0,NDefNfcTag::onWriteNdefFileCallback,&mCallBackStatus);
+	}
+
+	/**
+	 * Get the size of the NDEF file.
+	 * @return max number of bytes of a NDEF file, 2 length bytes included
+	 */
+	virtual uint32_t get_max_ndef_file_size() {
+		return Message::MAX_BYTE_LENGTH;
+	}
+
 	/**
 	 * Read a message from the tag.
 	 * @param[in,out] msg Message object the read records are added to.
@@ -252,6 +298,19 @@ private:
 	/** default callback object, all the functions are empty */
 	Callbacks mDefaultCallBack;
 
+	/**
+	 * Function called when a NDEF file image is written, it will invoke on_ndef_file_write
+	 * @param internalState Object that invokes the write operation.
+	 * @param status True if the operation had success.
+	 * @return true if the write had success
+	 */
+	static bool onWriteNdefFileCallback(CallbackStatus_t *internalState,
+			bool status,const uint8_t *, uint16_t ){
+		internalState->callOwner->mCallBack->
+			on_ndef_file_write(internalState->callOwner,status);
+		return status;
+	}
+
 	/**
 	 * Function called when a write operation completes, it will invoke on_message_write
 	 * @param internalState Object that invokes the write operation.
@@ -317,11 +376,13 @@ private:
 					on_message_read(internalState->callOwner,false,internalState->msg);
 			return false;
 		}
-		Message::parse_message(buffer, length, internalState->msg);
+		//a malformed message is reported as a failed read
+		const bool parsed = Message::parse_message(buffer, length,
+				internalState->msg) == Message::PARSE_OK;
 		delete [] buffer;
 		internalState->callOwner->mCallBack->
-			on_message_read(internalState->callOwner,true,internalState->msg);
-		return status ;
+			on_message_read(internalState->callOwner,parsed,internalState->msg);
+		return parsed;
 	}
 
 }; //class NDefNfcTagASync
@@ -46,6 +46,12 @@
 #define OPENSESSION_NTRIALS 5
 
 #define CC_FILE_LENGTH_BYTE 15
+
+/* size of the EEPROM page, slices that end on a page boundary avoid to
+ * program the same page twice */
+#ifndef M24SR_EEPROM_PAGE_SIZE
+	#define M24SR_EEPROM_PAGE_SIZE 16
+#endif
 ////////////////////////////START  OpenSessionCallBack/////////////////////////
 NDefNfcTagM24SR::OpenSessionCallBack::
 	OpenSessionCallBack(NDefNfcTagM24SR& sender):
@@ -90,8 +96,13 @@ void NDefNfcTagM24SR::OpenSessionCallBack::on_read_byte(M24SR *nfc,
 		return mSender.mCallBack->on_session_open(&mSender,false);
 	}//else
 	uint16_t NDefFileId = (uint16_t) ((readByte[0x09] << 8) | readByte[0x0A]);
+	const uint16_t maxWriteBytes = (uint16_t) ((readByte[0x05] << 8) | readByte[0x06]);
 	mSender.mMaxReadBytes = (uint16_t) ((readByte[0x03] << 8) | readByte[0x04]);
-	mSender.mMaxWriteBytes = (uint16_t) ((readByte[0x05] << 8) | readByte[0x06]);
+	mSender.mMaxNdefFileSize = (uint16_t) ((readByte[0x0B] << 8) | readByte[0x0C]);
+	if(mSender.mMaxWriteBytes!=maxWriteBytes){ //the old measures are not valid anymore
+		mSender.mMaxWriteBytes = maxWriteBytes;
+		mSender.reset_write_slice_cost();
+	}
 	nfc->select_NDEF_file(NDefFileId);
 }
 
@@ -121,29 +132,106 @@ bool NDefNfcTagM24SR::open_session(bool force) {
 }
 
 bool NDefNfcTagM24SR::close_session() {
+	const M24SR::NFC_GPO_MGMT rfGpo = mDevice.get_RF_GPO_config();
+	if(rfGpo!=M24SR::SESSION_OPENED && rfGpo!=M24SR::WIP){
+		//without the gpo we can't know if the tag is changed by the RF
+		mCacheTrusted=false;
+	}
 	mDevice.set_callback(&mCloseSessionCallback);
 	M24SR::StatusTypeDef status = mDevice.deselect();
 	return status == M24SR::M24SR_SUCCESS;
 }
 
+uint16_t NDefNfcTagM24SR::get_write_slice_candidate(uint8_t index)const{
+	uint16_t maxSlice = mMaxWriteBytes;
+	if(maxSlice>M24SR_MAX_BYTE_OPERATION_LENGHT)
+		maxSlice=M24SR_MAX_BYTE_OPERATION_LENGHT;
+	const uint16_t nPage = (uint16_t)((maxSlice/M24SR_EEPROM_PAGE_SIZE) >> index);
+	if(nPage==0) //at least one page, or everything if the max slice is smaller
+		return maxSlice < M24SR_EEPROM_PAGE_SIZE ? maxSlice : M24SR_EEPROM_PAGE_SIZE;
+	return (uint16_t)(nPage*M24SR_EEPROM_PAGE_SIZE);
+}
+
+uint16_t NDefNfcTagM24SR::get_write_slice_length(uint16_t offset,uint16_t remaining){
+	uint16_t slice = mMaxWriteBytes;
+	if(slice>M24SR_MAX_BYTE_OPERATION_LENGHT)
+		slice=M24SR_MAX_BYTE_OPERATION_LENGHT;
+
+	if(mSlicePolicy==ADAPTIVE){
+		//first try all the slice lengths, then use the fastest one
+		uint8_t best=0;
+		for(uint8_t i=0;i<N_WRITE_SLICE;i++){
+			if(mWriteSliceCost[i]==0){
+				best=i;
+				break;
+			}
+			if(mWriteSliceCost[i]<mWriteSliceCost[best])
+				best=i;
+		}//for
+		mWriteSliceIndex=best;
+		slice=get_write_slice_candidate(best);
+	}//if
+
+	if(mSlicePolicy!=MAX_SLICE && slice>=M24SR_EEPROM_PAGE_SIZE){
+		//move the end of the slice on a page boundary
+		const uint32_t end = ((uint32_t)offset+slice) -
+				(((uint32_t)offset+slice)%M24SR_EEPROM_PAGE_SIZE);
+		if(end>offset)
+			slice=(uint16_t)(end-offset);
+	}//if
+
+	return remaining<slice ? remaining : slice;
+}
+
+uint16_t NDefNfcTagM24SR::get_read_slice_length(uint16_t remaining)const{
+	//the read time doesn't depend on the EEPROM pages: the biggest slice is the fastest
+	uint16_t slice = mMaxReadBytes;
+	if(slice>M24SR_MAX_BYTE_OPERATION_LENGHT)
+		slice=M24SR_MAX_BYTE_OPERATION_LENGHT;
+	return remaining<slice ? remaining : slice;
+}
+
+void NDefNfcTagM24SR::update_write_slice_cost(uint16_t nByte,uint32_t elapsedUs){
+	//only full slices are a valid measure for the slice length
+	if(mSlicePolicy!=ADAPTIVE || nByte==0 ||
+			nByte!=get_write_slice_candidate(mWriteSliceIndex))
+		return;
+
+	uint32_t cost = (elapsedUs<<4)/nByte;
+	if(cost==0)
+		cost=1;
+	uint32_t &oldCost = mWriteSliceCost[mWriteSliceIndex];
+	if(oldCost==0)
+		oldCost=cost;
+	else //moving average, to follow the changes of the bus/chip speed
+		oldCost=(3*oldCost+cost)/4;
+}
+
+bool NDefNfcTagM24SR::WriteByteCallback::write_slice(M24SR *nfc,
+		uint16_t offset,const uint8_t *buffer){
+	const uint16_t length = mSender.get_write_slice_length(offset,
+			(uint16_t)(mNByteToWrite-mByteWrote));
+	mSliceStart=micros();
+	return nfc->update_binary(offset,length,(uint8_t*)buffer) == M24SR::M24SR_SUCCESS;
+}
+
 void NDefNfcTagM24SR::WriteByteCallback::on_updated_binary(M24SR *nfc,
 		M24SR::StatusTypeDef status,uint16_t startOffset, uint8_t *writeByte,uint16_t nWriteByte){
 
 	if(status!=M24SR::M24SR_SUCCESS){ // error -> finish to write
+		mSender.invalidate_read_cache(); //the file content is unknown
 		mCallback(mCallbackParam,false,mByteToWrite,mNByteToWrite);
 		return;
 	}//else
 
+	mSender.update_write_slice_cost(nWriteByte,(uint32_t)(micros()-mSliceStart));
+
 	mByteWrote+=nWriteByte;
 	if(mByteWrote==mNByteToWrite){ //write all -> finish
+		mSender.store_in_cache(mOffset,mByteToWrite,mNByteToWrite);
 		mCallback(mCallbackParam,true,mByteToWrite,mNByteToWrite);
 	}else{ //else write another slice
-		uint16_t tempLenght = 0;
-        if(mSender.mMaxWriteBytes < (uint16_t)(mNByteToWrite-mByteWrote))
-			tempLenght = mSender.mMaxWriteBytes;
-		else
-			tempLenght = (uint16_t)(mNByteToWrite-mByteWrote);
-		nfc->update_binary(startOffset+nWriteByte,tempLenght,writeByte+nWriteByte);
+		write_slice(nfc,startOffset+nWriteByte,writeByte+nWriteByte);
 	}//if-else
 }
 
@@ -152,14 +240,10 @@ bool NDefNfcTagM24SR::writeByte(const uint8_t *buffer, uint16_t length,uint16_t
 	if(!is_session_open())
 		callback(callbackStatus,false,buffer,length);
 	//else
-	mWriteByteCallback.set_task(buffer,length,callback,callbackStatus);
+	mWriteByteCallback.set_task(buffer,length,offset,callback,callbackStatus);
 	mDevice.set_callback(&mWriteByteCallback);
 
-	if (length > mMaxWriteBytes) {
-		return mDevice.update_binary(offset, mMaxWriteBytes,(uint8_t*) buffer) == M24SR::M24SR_SUCCESS;
-	}else{
-		return mDevice.update_binary(offset,length,(uint8_t*)buffer) == M24SR::M24SR_SUCCESS;
-	}//if-else
+	return mWriteByteCallback.write_slice(&mDevice,offset,buffer);
 
 }
 
@@ -173,13 +257,12 @@ void NDefNfcTagM24SR::ReadByteCallback::on_read_byte(M24SR *nfc,
 
 	mByteRead += nReadByte;
 	if(mByteRead==mNByteToRead){ //read all -> finish
+		if(mStoreInCache)
+			mSender.store_in_cache(mOffset,mBuffer,mNByteToRead);
 		mCallback(mCallbackParam,true,mBuffer,mNByteToRead);
 	}else{ //else write another slice
-		uint16_t tempLenght = 0;
-		if(mSender.mMaxReadBytes < (uint16_t)(mNByteToRead-mByteRead))
-			tempLenght = mSender.mMaxReadBytes;
-		else
-			tempLenght = (uint16_t)(mNByteToRead-mByteRead);
+		const uint16_t tempLenght = mSender.get_read_slice_length(
+				(uint16_t)(mNByteToRead-mByteRead));
 		nfc->read_binary(startOffset+nReadByte,tempLenght,readBffer+nReadByte);
 	}//if-else
 
@@ -191,13 +274,50 @@ bool NDefNfcTagM24SR::readByte(const uint16_t byteOffset, const uint16_t length,
 		return callback(callbackStatus,false,buffer,length);
 	}
 	//else
-	mReadByteCallback.set_task(buffer,length,callback,callbackStatus);
+	//a copy that is not trusted can be stale even if its first bytes are equal
+	if(mCacheEnabled && mCacheTrusted && (uint32_t)byteOffset+length<=mCacheLength){
+		memcpy(buffer,mCache+byteOffset,length);
+		return callback(callbackStatus,true,buffer,length);
+	}//if
+
+	mReadByteCallback.set_task(buffer,length,byteOffset,mCacheEnabled,callback,callbackStatus);
 	mDevice.set_callback(&mReadByteCallback);
 
-	if (length > mMaxReadBytes) {
-		return mDevice.read_binary(byteOffset, mMaxReadBytes,buffer)== M24SR::M24SR_SUCCESS;;
-	}else{
-		return mDevice.read_binary(byteOffset,length,buffer)== M24SR::M24SR_SUCCESS;;
-	}//if-else
+	return mDevice.read_binary(byteOffset,get_read_slice_length(length),buffer)== M24SR::M24SR_SUCCESS;
+
+}
+
+void NDefNfcTagM24SR::store_in_cache(uint16_t offset,const uint8_t *buffer,
+		uint16_t length){
+	if(!mCacheEnabled)
+		return;
+
+	if(offset==0){ //new copy of the file, the old bytes can be stale
+		mCacheLength=0;
+		mCacheTrusted=true;
+	}else if(offset>mCacheLength) //the cache contains only contiguous bytes
+		return;
+
+	const uint32_t newLength = (uint32_t)offset+length;
+	if(newLength>0xFFFF){
+		invalidate_read_cache();
+		return;
+	}//if
+
+	if(newLength>mCacheSize){
+		uint8_t *newCache = new uint8_t[newLength];
+		if(newCache==NULL){ //impossible to allocate the buffer
+			invalidate_read_cache();
+			return;
+		}//if
+		if(mCacheLength!=0)
+			memcpy(newCache,mCache,mCacheLength);
+		delete [] mCache;
+		mCache=newCache;
+		mCacheSize=(uint16_t)newLength;
+	}//if
 
+	memcpy(mCache+offset,buffer,length);
+	if(newLength>mCacheLength)
+		mCacheLength=(uint16_t)newLength;
 }
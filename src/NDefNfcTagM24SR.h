@@ -39,6 +39,7 @@
 #define M24SR_NDEFNFCTAGM24SR_H_
 
 #include <cstdlib>
+#include <cstring>
 #include <stdint.h>
 
 #include "NDefNfcTag.h"
@@ -52,6 +53,15 @@ class NDefNfcTagM24SR: public NDefLib::NDefNfcTag {
 
 public:
 
+	/**
+	 * Policy used to split a read/write operation in many commands
+	 */
+	typedef enum {
+		MAX_SLICE,    /**< use the biggest slice allowed by the CC file */
+		PAGE_ALIGNED, /**< as MAX_SLICE, but each write ends on an EEPROM page boundary */
+		ADAPTIVE      /**< page aligned writes, the slice length is chosen measuring the write time */
+	} SlicePolicy_t;
+
 	/**
 	 *
 	 * @param device device to use
@@ -59,11 +69,15 @@ public:
 	NDefNfcTagM24SR(M24SR &device):
 		NDefLib::NDefNfcTag(),
 		mDevice(device),mIsSessionOpen(false),
-		mMaxReadBytes(0xFF), mMaxWriteBytes(0xFF),
+		mMaxReadBytes(0xFF), mMaxWriteBytes(0xFF), mMaxNdefFileSize(0),
+		mSlicePolicy(PAGE_ALIGNED),mWriteSliceIndex(0),
+		mCacheEnabled(false),mCache(NULL),mCacheSize(0),mCacheLength(0),mCacheTrusted(false),
 		mOpenSessionCallback(*this),
 		mCloseSessionCallback(*this),
 		mWriteByteCallback(*this),
-		mReadByteCallback(*this){}
+		mReadByteCallback(*this){
+			reset_write_slice_cost();
+		}
 
 	virtual bool open_session(bool force = false);
 
@@ -73,12 +87,79 @@ public:
 		return mIsSessionOpen;
 	}
 
+	/**
+	 * Get the NDEF file size read from the CC file when the session is open.
+	 * @return max number of bytes of a NDEF file, 2 length bytes included
+	 */
+	virtual uint32_t get_max_ndef_file_size(){
+		return mMaxNdefFileSize;
+	}
+
+	/**
+	 * Change the way a long read/write is split in many commands.
+	 * @param policy New policy.
+	 */
+	void set_slice_policy(SlicePolicy_t policy){
+		mSlicePolicy=policy;
+	}
+
+	/**
+	 * @return Policy used to split a long read/write.
+	 */
+	SlicePolicy_t get_slice_policy()const{
+		return mSlicePolicy;
+	}
+
+	/**
+	 * Keep in RAM a copy of the NDEF file, so that reading again an unchanged
+	 * message doesn't need to read it from the tag.
+	 * @par The copy is trusted until the session is closed. If the RF GPO is
+	 * configured as SESSION_OPENED or WIP (see M24SR::manage_RF_GPO) it is trusted
+	 * until notify_RF_activity is called. A copy that is not trusted is never used:
+	 * the next read gets the file from the tag and replaces the copy.
+	 * @param enable true to enable the cache, false to disable it and free its memory.
+	 */
+	void set_read_cache(bool enable){
+		mCacheEnabled=enable;
+		if(!enable)
+			invalidate_read_cache();
+	}
+
+	/**
+	 * @return true if the read cache is enabled
+	 */
+	bool is_read_cache_enabled()const{
+		return mCacheEnabled;
+	}
+
+	/**
+	 * Tell that the tag can be changed through the RF channel, the next read
+	 * will get the file from the tag.
+	 * @par It is safe to call this function inside the GPO interrupt.
+	 */
+	void notify_RF_activity(){
+		mCacheTrusted=false;
+	}
+
+	/**
+	 * Remove the cached copy of the NDEF file.
+	 * @par Call it after writing the NDEF file without using this class.
+	 */
+	void invalidate_read_cache(){
+		delete [] mCache;
+		mCache=NULL;
+		mCacheSize=0;
+		mCacheLength=0;
+		mCacheTrusted=false;
+	}
+
 	/**
 	* Close the open session.
 	*/
 	virtual ~NDefNfcTagM24SR(){
 		if(is_session_open())
 			close_session();
+		delete [] mCache;
 	}//~NDefNfcTagM24SR
 
 	protected:
@@ -108,6 +189,99 @@ public:
 		*/
 		uint16_t mMaxWriteBytes;
 
+		/**
+		 * NDEF file size read from the CC file, 2 length bytes included
+		 */
+		uint16_t mMaxNdefFileSize;
+
+		/**
+		 * Policy used to split the read/write operations
+		 */
+		SlicePolicy_t mSlicePolicy;
+
+		/**
+		 * Number of slice lengths tested by the ADAPTIVE policy
+		 */
+		static const uint8_t N_WRITE_SLICE = 4;
+
+		/**
+		 * Measured write time for each slice length, in 1/16 microsecond per byte, 0 if unknown
+		 */
+		uint32_t mWriteSliceCost[N_WRITE_SLICE];
+
+		/**
+		 * Index of the slice length used by the last write
+		 */
+		uint8_t mWriteSliceIndex;
+
+		/**
+		 * Forget the measured write times.
+		 */
+		void reset_write_slice_cost(){
+			memset(mWriteSliceCost,0,sizeof(mWriteSliceCost));
+		}
+
+		/**
+		 * @param index Slice index, 0 is the biggest one.
+		 * @return Length of the slice for the ADAPTIVE policy.
+		 */
+		uint16_t get_write_slice_candidate(uint8_t index)const;
+
+		/**
+		 * Compute the length of the next write command.
+		 * @param offset Offset of the first byte to write.
+		 * @param remaining Number of bytes still to write.
+		 * @return Number of bytes to write with the next command.
+		 */
+		uint16_t get_write_slice_length(uint16_t offset,uint16_t remaining);
+
+		/**
+		 * Compute the length of the next read command.
+		 * @param remaining Number of bytes still to read.
+		 * @return Number of bytes to read with the next command.
+		 */
+		uint16_t get_read_slice_length(uint16_t remaining)const;
+
+		/**
+		 * Store the time needed to write a slice, used by the ADAPTIVE policy.
+		 * @param nByte Number of bytes wrote.
+		 * @param elapsedUs Time needed to write them, in microseconds.
+		 */
+		void update_write_slice_cost(uint16_t nByte,uint32_t elapsedUs);
+
+		/**
+		 * true if the read cache is enabled
+		 */
+		bool mCacheEnabled;
+
+		/**
+		 * Copy of the first mCacheLength bytes of the NDEF file
+		 */
+		uint8_t *mCache;
+
+		/**
+		 * Size of the mCache buffer
+		 */
+		uint16_t mCacheSize;
+
+		/**
+		 * Number of bytes in the cache
+		 */
+		uint16_t mCacheLength;
+
+		/**
+		 * true if the tag can't be changed since the cache was checked
+		 */
+		volatile bool mCacheTrusted;
+
+		/**
+		 * Copy the data read/wrote from/to the tag inside the cache.
+		 * @param offset Offset of the first byte.
+		 * @param buffer Data to copy.
+		 * @param length Number of bytes to copy.
+		 */
+		void store_in_cache(uint16_t offset,const uint8_t *buffer,uint16_t length);
+
 		/**
 		 * Class containing the callback needed to open a session and read the max
 		 * read/write size
@@ -184,7 +358,9 @@ public:
 				WriteByteCallback(NDefNfcTagM24SR &sender):
 									mByteToWrite(NULL),
 									mNByteToWrite(0),
+									mOffset(0),
 									mByteWrote(0),
+									mSliceStart(0),
 									mCallback(NULL),
 									mCallbackParam(NULL),
 									mSender(sender){}
@@ -193,18 +369,30 @@ public:
 				 * Set the buffer to write and the function to call when finish
 				 * @param buffer Buffer to write.
 				 * @param nByte Number of bytes to write.
+				 * @param offset Offset where write the buffer.
 				 * @param callback Function to call when the write ends.
 				 * @param param Parameter to pass to the callback function.
 				 */
-				void set_task(const uint8_t *buffer,uint16_t nByte,
+				void set_task(const uint8_t *buffer,uint16_t nByte,uint16_t offset,
 						byteOperationCallback_t callback,CallbackStatus_t *param){
 					mByteToWrite=buffer;
+					mOffset=offset;
 					mNByteToWrite=nByte;
 					mByteWrote=0;
 					mCallback = callback;
 					mCallbackParam = param;
 				}
 
+				/**
+				 * Write the next slice of the buffer.
+				 * @param nfc Device where write the data.
+				 * @param offset Offset where write the slice.
+				 * @param buffer First byte of the slice.
+				 * @return true if the command is sent
+				 */
+				bool write_slice(M24SR *nfc,uint16_t offset,
+						const uint8_t *buffer);
+
 				virtual void on_updated_binary(M24SR *nfc,M24SR::StatusTypeDef status,
 						uint16_t startOffset,uint8_t *writeByte,uint16_t nWriteByte);
 
@@ -215,8 +403,12 @@ public:
 				const uint8_t *mByteToWrite;
 				/** length of the buffer */
 				uint16_t mNByteToWrite;
+				/** offset where write the buffer */
+				uint16_t mOffset;
 				/** number of byte already wrote */
 				uint16_t mByteWrote;
+				/** time when the last slice was sent, in microseconds */
+				uint32_t mSliceStart;
 
 				/** function to call when all the bytes are write */
 				byteOperationCallback_t mCallback;
@@ -243,7 +435,9 @@ public:
 				ReadByteCallback(NDefNfcTagM24SR &sender):
 										mBuffer(NULL),
 										mNByteToRead(0),
+										mOffset(0),
 										mByteRead(0),
+										mStoreInCache(false),
 										mCallback(NULL),
 										mCallbackParam(NULL),
 										mSender(sender){}
@@ -252,13 +446,17 @@ public:
 				 * Set the buffer where read the data and the function to call when finish
 				 * @param buffer Buffer read
 				 * @param nByte Number of bytes to read
+				 * @param offset Offset where start to read
+				 * @param storeInCache true to copy the read bytes in the cache
 				 * @param callback Function to call when the read ends
 				 * @param param Parameter to pass to the callback function
 				 */
-				void set_task(uint8_t *buffer,uint16_t nByte,
+				void set_task(uint8_t *buffer,uint16_t nByte,uint16_t offset,bool storeInCache,
 						byteOperationCallback_t callback,CallbackStatus_t *param){
 					mBuffer=buffer;
 					mNByteToRead=nByte;
+					mOffset=offset;
+					mStoreInCache=storeInCache;
 					mByteRead=0;
 					mCallback = callback;
 					mCallbackParam = param;
@@ -280,11 +478,21 @@ public:
 				 */
 				uint16_t mNByteToRead;
 
+				/**
+				 * Offset of the first byte to read
+				 */
+				uint16_t mOffset;
+
 				/**
 				 * Number of bytes already read
 				 */
 				uint16_t mByteRead;
 
+				/**
+				 * true if the read bytes have to be copied in the cache
+				 */
+				bool mStoreInCache;
+
 				/**
 				 * Function to call when all the bytes are read
 				 */
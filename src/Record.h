@@ -38,6 +38,8 @@
 #ifndef NDEFLIB_RECORD_H_
 #define NDEFLIB_RECORD_H_
 #include <stdint.h>
+#include <cstring>
+#include <string>
 
 #include "RecordHeader.h"
 
@@ -63,7 +65,13 @@ public:
 		TYPE_URI_SMS,        //!< SMS URI record
 		TYPE_URI_GEOLOCATION,//!< position URI record
 		TYPE_MIME_VCARD,     //!< VCard record
-		TYPE_WIFI_CONF 		 //!< Wifi configuration
+		TYPE_WIFI_CONF, 	 //!< Wifi configuration
+		TYPE_HANDOVER,       //!< Connection handover select or request
+		TYPE_ALTERNATIVE_CARRIER, //!< Handover alternative carrier
+		TYPE_MIME_BLUETOOTH_OOB,  //!< Bluetooth out of band pairing data
+		TYPE_SMART_POSTER,   //!< Smart poster
+		TYPE_EXTERNAL,       //!< NFC Forum external type
+		TYPE_ABSOLUTE_URI    //!< Record type is an absolute URI
 	} RecordType_t;
 
 	Record() {
@@ -125,6 +133,34 @@ public:
 	} //getType
 
 
+	/**
+	 * Set the record id, used to reference this record from other records.
+	 * @param id Record id, an empty string removes the id. Only the first 255
+	 * bytes are used.
+	 */
+	void set_id(const std::string &id) {
+		mId = id.substr(0, 0xFF);
+		mRecordHeader.set_id_length(mId.size());
+	}
+
+	/**
+	 * Get the record id.
+	 * @return record id, empty if the record has not an id
+	 */
+	const std::string& get_id() const {
+		return mId;
+	}
+
+	/**
+	 * Load the record id from a buffer.
+	 * @param header Record header.
+	 * @param buffer Buffer that points to the record type, the id follows the type.
+	 */
+	void load_id(const RecordHeader &header, const uint8_t *buffer) {
+		set_id(std::string((const char*) buffer + header.get_type_length(),
+				header.get_id_length()));
+	}
+
 	/**
 	 * Get the record header.
 	 * @return record header
@@ -136,8 +172,9 @@ public:
 	/**
 	 * Number of bytes needed to store this record.
 	 * @return size of the header + size of the record content
+	 * @par The value is 32 bits wide: a record can be longer than a NDEF file.
 	 */
-	virtual uint16_t get_byte_length() {
+	virtual uint32_t get_byte_length() {
 		return mRecordHeader.get_record_length();
 	}
 
@@ -153,7 +190,21 @@ public:
 	};
 
 protected:
+
+	/**
+	 * Write the record id, it must be called after writing the record type.
+	 * @param[out] buffer Buffer to write the id into.
+	 * @return number of write bytes
+	 */
+	uint16_t write_id(uint8_t *buffer) const {
+		std::memcpy(buffer, mId.data(), mId.size());
+		return mId.size();
+	}
+
 	RecordHeader mRecordHeader;
+
+private:
+	std::string mId;
 };
 
 } /* namespace NDefLib */
@@ -55,6 +55,7 @@ uint16_t RecordAAR::write(uint8_t *buffer) {
 	offset += mRecordHeader.write_header(buffer);
 	std::memcpy(buffer + offset, sRecordType, sizeof(sRecordType));
 	offset += sizeof(sRecordType);
+	offset += write_id(buffer + offset);
 	std::memcpy(buffer + offset, mPackageName.c_str(), mPackageName.size());
 	offset += mPackageName.size();
 	return offset;
@@ -64,7 +65,7 @@ RecordAAR* RecordAAR::parse(const RecordHeader &header,
 		const uint8_t *buffer) {
 	uint8_t offset = 0;
 	if ((header.get_FNT() != RecordHeader::NFC_external)
-			&& (header.get_type_length() != sizeof(sRecordType))) {
+			|| (header.get_type_length() != sizeof(sRecordType))) {
 		return NULL;
 	} //else
 
@@ -72,7 +73,7 @@ RecordAAR* RecordAAR::parse(const RecordHeader &header,
 		return NULL;
 	} //else tagType == android.com:pkg
 
-	offset += sizeof(sRecordType);
+	offset += sizeof(sRecordType) + header.get_id_length();
 
 	return new RecordAAR(
 			std::string((const char*) buffer + offset,
@@ -0,0 +1,100 @@
+/**
+ ******************************************************************************
+ * @file    RecordAbsoluteUri.h
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   Record with an absolute URI as record type
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+#ifndef NDEFLIB_RECORDTYPE_RECORDABSOLUTEURI_H_
+#define NDEFLIB_RECORDTYPE_RECORDABSOLUTEURI_H_
+
+#include "RecordBinary.h"
+
+namespace NDefLib {
+
+/**
+ * Record with the absolute URI type name format: the record type is an URI
+ * (RFC 3986) that describes the payload.
+ * @par Use {@link RecordURI} to store an URI that the phone has to open.
+ */
+class RecordAbsoluteUri: public RecordBinary {
+public:
+
+	/**
+	 * Create a RecordAbsoluteUri reading the data from the buffer.
+ 	 * @param header Record header.
+	 * @param buffer Buffer to read the data from.
+	 * @return an object of type RecordAbsoluteUri or NULL
+	 * @par User is in charge of freeing the pointer returned by this function.
+	 */
+	static RecordAbsoluteUri* parse(const RecordHeader &header,
+			const uint8_t *buffer){
+		if (header.get_FNT() != RecordHeader::Absolute_URI)
+			return NULL;
+		return new RecordAbsoluteUri(
+				std::string((const char*) buffer, header.get_type_length()),
+				buffer + header.get_type_length() + header.get_id_length(),
+				header.get_payload_length());
+	}
+
+	/**
+	 * Create a new record.
+	 * @param uri Absolute URI used as record type.
+	 * @param data Payload, it is copied inside the class.
+	 * @param dataLength Payload length in bytes.
+	 */
+	explicit RecordAbsoluteUri(const std::string &uri, const uint8_t *data=NULL,
+			uint32_t dataLength=0):
+		RecordBinary(RecordHeader::Absolute_URI,uri,data,dataLength){ }
+
+    /**
+     * Get the record type.
+     * @return TYPE_ABSOLUTE_URI
+	 */
+	virtual RecordType_t get_type() const {
+		return TYPE_ABSOLUTE_URI;
+	} //getType
+
+	/**
+	 * @return the absolute URI stored as record type
+	 */
+	const std::string& get_uri() const {
+		return get_type_string();
+	}
+
+	virtual ~RecordAbsoluteUri() { }
+};
+
+} /* namespace NDefLib */
+
+#endif /* NDEFLIB_RECORDTYPE_RECORDABSOLUTEURI_H_ */
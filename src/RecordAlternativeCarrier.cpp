@@ -0,0 +1,136 @@
+/**
+ ******************************************************************************
+ * @file    RecordAlternativeCarrier.cpp
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   RecordAlternativeCarrier implementation.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+#include <cstring>
+#include "RecordAlternativeCarrier.h"
+
+namespace NDefLib {
+
+const char RecordAlternativeCarrier::sRecordType[] = { 'a', 'c' };
+
+RecordAlternativeCarrier::RecordAlternativeCarrier(
+		const std::string &carrierDataReference,
+		CarrierPowerState_t powerState) :
+		mPowerState(powerState), mCarrierDataReference(carrierDataReference) {
+	mRecordHeader.set_FNT(RecordHeader::NFC_well_known);
+	mRecordHeader.set_type_length(sizeof(sRecordType));
+	update_payload_length();
+}
+
+void RecordAlternativeCarrier::update_payload_length() {
+	//power state + reference length + reference + number of auxiliary references
+	uint32_t length = 1 + 1 + mCarrierDataReference.size() + 1;
+	for (uint32_t i = 0; i < mAuxiliaryDataReferences.size(); i++)
+		length += 1 + mAuxiliaryDataReferences[i].size();
+	mRecordHeader.set_payload_length(length);
+}
+
+/**
+ * Write a string prefixed by its length.
+ * @return number of bytes written
+ */
+static uint16_t write_reference(uint8_t *buffer, const std::string &reference) {
+	buffer[0] = (uint8_t) reference.size();
+	std::memcpy(buffer + 1, reference.data(), reference.size());
+	return 1 + reference.size();
+}
+
+uint16_t RecordAlternativeCarrier::write(uint8_t *buffer) {
+	uint16_t offset = 0;
+	offset += mRecordHeader.write_header(buffer);
+	std::memcpy(buffer + offset, sRecordType, sizeof(sRecordType));
+	offset += sizeof(sRecordType);
+	offset += write_id(buffer + offset);
+
+	buffer[offset++] = (uint8_t) mPowerState;
+	offset += write_reference(buffer + offset, mCarrierDataReference);
+	buffer[offset++] = (uint8_t) mAuxiliaryDataReferences.size();
+	for (uint32_t i = 0; i < mAuxiliaryDataReferences.size(); i++)
+		offset += write_reference(buffer + offset, mAuxiliaryDataReferences[i]);
+	return offset;
+}
+
+RecordAlternativeCarrier* RecordAlternativeCarrier::parse(
+		const RecordHeader &header, const uint8_t * const buffer) {
+	if ((header.get_FNT() != RecordHeader::NFC_well_known)
+			|| (header.get_type_length() != sizeof(sRecordType))) {
+		return NULL;
+	} //else
+
+	if (std::memcmp(buffer, sRecordType, sizeof(sRecordType)) != 0) {
+		return NULL;
+	} //else tagType == ac
+
+	const uint8_t *payload = buffer + sizeof(sRecordType) + header.get_id_length();
+	const uint32_t length = header.get_payload_length();
+	uint32_t offset = 0;
+
+	//power state + reference length
+	if (length < 2)
+		return NULL;
+	const CarrierPowerState_t powerState =
+			(CarrierPowerState_t) (payload[offset++] & 0x03);
+	uint8_t referenceLength = payload[offset++];
+	//+1 = number of auxiliary references
+	if (length - offset < referenceLength + 1u)
+		return NULL;
+
+	RecordAlternativeCarrier *r = new RecordAlternativeCarrier(
+			std::string((const char*) payload + offset, referenceLength),
+			powerState);
+	offset += referenceLength;
+
+	const uint8_t nAuxiliaryReferences = payload[offset++];
+	for (uint8_t i = 0; i < nAuxiliaryReferences; i++) {
+		if (offset == length) {
+			delete r;
+			return NULL;
+		} //if
+		referenceLength = payload[offset++];
+		if (length - offset < referenceLength) {
+			delete r;
+			return NULL;
+		} //if
+		r->mAuxiliaryDataReferences.push_back(
+				std::string((const char*) payload + offset, referenceLength));
+		offset += referenceLength;
+	} //for
+
+	r->update_payload_length();
+	return r;
+}
+
+} /* namespace NDefLib */
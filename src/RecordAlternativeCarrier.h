@@ -0,0 +1,185 @@
+/**
+ ******************************************************************************
+ * @file    RecordAlternativeCarrier.h
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   Record that links a handover message to a carrier configuration record
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+#ifndef NDEFLIB_RECORDTYPE_RECORDALTERNATIVECARRIER_H_
+#define NDEFLIB_RECORDTYPE_RECORDALTERNATIVECARRIER_H_
+
+#include <string>
+#include <vector>
+
+#include "Record.h"
+
+namespace NDefLib {
+
+/**
+ * Alternative carrier record ("ac"), used inside a {@link RecordHandover} to reference
+ * the record that contains the carrier configuration.
+ * @see NFC Forum Connection Handover Technical Specification
+ */
+class RecordAlternativeCarrier: public Record {
+public:
+
+	/**
+	 * Carrier power state
+	 */
+	typedef enum {
+		CPS_INACTIVE = 0x00,  //!< the carrier is off
+		CPS_ACTIVE = 0x01,    //!< the carrier is on
+		CPS_ACTIVATING = 0x02,//!< the carrier is turning on
+		CPS_UNKNOWN = 0x03    //!< the power state is not known
+	} CarrierPowerState_t;
+
+	/**
+	 * Create an RecordAlternativeCarrier reading the data from the buffer.
+ 	 * @param header Record header.
+	 * @param buffer Buffer to read the data from.
+	 * @return an object of type RecordAlternativeCarrier or NULL
+	 * @par User is in charge of freeing the pointer returned by this function.
+	 */
+	static RecordAlternativeCarrier* parse(const RecordHeader &header,
+			const uint8_t * const buffer);
+
+	/**
+	 * Build a new record.
+	 * @param carrierDataReference Id of the record with the carrier configuration.
+	 * @param powerState Carrier power state.
+	 */
+	explicit RecordAlternativeCarrier(const std::string &carrierDataReference,
+			CarrierPowerState_t powerState=CPS_ACTIVE);
+
+    /**
+     * Get the record type.
+     * @return TYPE_ALTERNATIVE_CARRIER
+	 */
+	virtual RecordType_t get_type() const {
+		return TYPE_ALTERNATIVE_CARRIER;
+	} //getType
+
+	/**
+	 * Get the carrier power state.
+	 * @return carrier power state
+	 */
+	CarrierPowerState_t get_power_state() const {
+		return mPowerState;
+	}
+
+	/**
+	 * Change the carrier power state.
+	 * @param powerState new power state
+	 */
+	void set_power_state(CarrierPowerState_t powerState){
+		mPowerState=powerState;
+	}
+
+	/**
+	 * Get the id of the record with the carrier configuration.
+	 * @return carrier data reference
+	 */
+	const std::string& get_carrier_data_reference() const {
+		return mCarrierDataReference;
+	}
+
+	/**
+	 * Change the id of the record with the carrier configuration.
+	 * @param reference new carrier data reference, at most 255 chars
+	 */
+	void set_carrier_data_reference(const std::string &reference){
+		mCarrierDataReference=reference;
+		update_payload_length();
+	}
+
+	/**
+	 * Get the ids of the records with auxiliary data for the carrier.
+	 * @return auxiliary data references
+	 */
+	const std::vector<std::string>& get_auxiliary_data_references() const {
+		return mAuxiliaryDataReferences;
+	}
+
+	/**
+	 * Add the id of a record with auxiliary data for the carrier.
+	 * @param reference auxiliary data reference, at most 255 chars
+	 */
+	void add_auxiliary_data_reference(const std::string &reference){
+		mAuxiliaryDataReferences.push_back(reference);
+		update_payload_length();
+	}
+
+	virtual uint16_t write(uint8_t *buffer);
+	virtual ~RecordAlternativeCarrier() { };
+
+	/**
+	 * compare two objects
+	 * @return true if the records have the same power state and references
+	 */
+	bool operator==(const RecordAlternativeCarrier &other) const{
+		return 	(mPowerState==other.mPowerState) &&
+				(mCarrierDataReference==other.mCarrierDataReference) &&
+				(mAuxiliaryDataReferences==other.mAuxiliaryDataReferences);
+	}
+
+private:
+
+	/**
+	 * Set the correct size of the payload.
+	 */
+	void update_payload_length();
+
+	/**
+	 * Carrier power state
+	 */
+	CarrierPowerState_t mPowerState;
+
+	/**
+	 * Id of the record with the carrier configuration
+	 */
+	std::string mCarrierDataReference;
+
+	/**
+	 * Ids of the records with auxiliary data
+	 */
+	std::vector<std::string> mAuxiliaryDataReferences;
+
+	/**
+	 * String to use as record type for this record
+	 */
+	static const char sRecordType[];
+};
+
+} /* namespace NDefLib */
+
+#endif /* NDEFLIB_RECORDTYPE_RECORDALTERNATIVECARRIER_H_ */
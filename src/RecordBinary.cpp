@@ -0,0 +1,74 @@
+/**
+ ******************************************************************************
+ * @file    RecordBinary.cpp
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   RecordBinary implementation.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+#include "RecordBinary.h"
+
+namespace NDefLib {
+
+RecordBinary::RecordBinary(RecordHeader::TypeNameFormat_t tnf,
+		const std::string &type, const uint8_t *data, uint32_t dataLength) :
+		mType(type), mPayload(NULL), mPayloadLength(0), mPayloadToFree(false) {
+	mRecordHeader.set_FNT(tnf);
+	mRecordHeader.set_type_length(mType.size());
+	copy_payload(data, dataLength);
+}
+
+void RecordBinary::copy_payload(const uint8_t *data, uint32_t dataLength) {
+	delete_payload();
+	if (data != NULL && dataLength != 0) {
+		uint8_t *payload = new uint8_t[dataLength];
+		std::memcpy(payload, data, dataLength);
+		mPayload = payload;
+		mPayloadToFree = true;
+	} else
+		dataLength = 0;
+	mPayloadLength = dataLength;
+	mRecordHeader.set_payload_length(dataLength);
+}
+
+uint16_t RecordBinary::write(uint8_t *buffer) {
+	uint16_t offset = 0;
+	offset += mRecordHeader.write_header(buffer);
+	std::memcpy(buffer + offset, mType.data(), mType.size());
+	offset += mType.size();
+	offset += write_id(buffer + offset);
+	if (mPayloadLength != 0)
+		std::memcpy(buffer + offset, mPayload, mPayloadLength);
+	offset += mPayloadLength;
+	return offset;
+}
+
+} /* namespace NDefLib */
@@ -0,0 +1,158 @@
+/**
+ ******************************************************************************
+ * @file    RecordBinary.h
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   Record with a type string and a binary payload
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+#ifndef NDEFLIB_RECORDTYPE_RECORDBINARY_H_
+#define NDEFLIB_RECORDTYPE_RECORDBINARY_H_
+
+#include <cstring>
+#include <string>
+
+#include "Record.h"
+
+namespace NDefLib {
+
+/**
+ * {@link Record} that stores the record type as a string and the payload as a
+ * sequence of bytes, without interpreting them.
+ * @par The payload is copied inside the class, unless it is set with
+ * {@link RecordBinary#set_payload_pointer}.
+ */
+class RecordBinary: public Record {
+public:
+
+	/**
+	 * Create a new record.
+	 * @param tnf Type name format.
+	 * @param type Record type.
+	 * @param data Payload, it is copied inside the class.
+	 * @param dataLength Payload length in bytes.
+	 */
+	RecordBinary(RecordHeader::TypeNameFormat_t tnf, const std::string &type,
+			const uint8_t *data=NULL, uint32_t dataLength=0);
+
+	/**
+	 * Get the record type.
+	 * @return string stored in the record type field
+	 */
+	const std::string& get_type_string() const {
+		return mType;
+	}
+
+	/**
+	 * @return pointer to the payload
+	 * @par DO NOT free this pointer, it is managed by the class.
+	 */
+	const uint8_t* get_payload() const {
+		return mPayload;
+	}
+
+	/**
+	 * @return number of bytes of the payload
+	 */
+	uint32_t get_payload_length() const {
+		return mPayloadLength;
+	}
+
+	/**
+	 * Change the payload, the data are copied inside the object.
+	 * @param data Pointer to the data buffer.
+	 * @param dataLength Number of bytes to write.
+	 */
+	void copy_payload(const uint8_t *data, uint32_t dataLength);
+
+	/**
+	 * Change the payload pointer used by this record.
+	 * @param data Pointer used by this record.
+	 * @param dataLength Number of byte to write in this record.
+	 * @par The buffer is not copied or freed by this class, so it must not be
+	 * freed before the object is deallocated.
+	 */
+	void set_payload_pointer(const uint8_t *data, uint32_t dataLength){
+		delete_payload();
+		mPayload = data;
+		mPayloadLength = dataLength;
+		mRecordHeader.set_payload_length(dataLength);
+	}
+
+	virtual uint16_t write(uint8_t *buffer);
+
+	/**
+	 * Compare two objects
+	 * @return true if the 2 records have the same type name format, type and payload
+	 */
+	bool operator==(const RecordBinary &other) const {
+		return 	mRecordHeader.get_FNT()==other.mRecordHeader.get_FNT() &&
+				mType==other.mType &&
+				mPayloadLength == other.mPayloadLength &&
+				(mPayloadLength==0 ||
+						std::memcmp(mPayload,other.mPayload,mPayloadLength)==0);
+	}
+
+	/**
+	 * If needed free the memory used to store the payload.
+	 */
+	virtual ~RecordBinary() {
+		delete_payload();
+	}
+
+private:
+
+	/**
+	 * The payload can be owned, copies are not allowed.
+	 */
+	RecordBinary(const RecordBinary&);
+	RecordBinary& operator=(const RecordBinary&);
+
+	/**
+	 * Delete the payload buffer if it is allocated by this class.
+	 */
+	void delete_payload(){
+		if(mPayloadToFree)
+			delete [] mPayload;
+		mPayloadToFree=false;
+		mPayload=NULL;
+	}
+
+	const std::string mType;
+	const uint8_t *mPayload;
+	uint32_t mPayloadLength;
+	bool mPayloadToFree;
+};
+
+} /* namespace NDefLib */
+
+#endif /* NDEFLIB_RECORDTYPE_RECORDBINARY_H_ */
@@ -0,0 +1,255 @@
+/**
+ ******************************************************************************
+ * @file    RecordBluetoothOob.cpp
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   RecordBluetoothOob implementation.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+#include <cstring>
+
+#include "RecordBluetoothOob.h"
+
+namespace NDefLib {
+
+const std::string RecordBluetoothOob::sBrEdrMimeType("application/vnd.bluetooth.ep.oob");
+const std::string RecordBluetoothOob::sLeMimeType("application/vnd.bluetooth.le.oob");
+
+//size of the OOB data length at the beginning of a BR/EDR record
+#define OOB_LENGTH_SIZE 2
+//address + address type
+#define LE_ADDRESS_FIELD_LENGTH (RecordBluetoothOob::ADDRESS_LENGTH+1)
+
+RecordBluetoothOob::RecordBluetoothOob(Transport_t transport,
+		const uint8_t *address, bool isRandomAddress) :
+		RecordMimeType(transport == BR_EDR ? sBrEdrMimeType : sLeMimeType),
+		mTransport(transport), mIsRandomAddress(isRandomAddress) {
+	std::memcpy(mAddress, address, ADDRESS_LENGTH);
+	update_payload_length();
+}
+
+const std::string* RecordBluetoothOob::get_field(uint8_t type) const {
+	for (uint32_t i = 0; i < mFields.size(); i++) {
+		if (mFields[i].type == type)
+			return &mFields[i].data;
+	} //for
+	return NULL;
+}
+
+void RecordBluetoothOob::set_field(uint8_t type, const std::string &data) {
+	if (type == LE_DEVICE_ADDRESS)
+		return;
+	for (uint32_t i = 0; i < mFields.size(); i++) {
+		if (mFields[i].type == type) {
+			mFields[i].data = data;
+			update_payload_length();
+			return;
+		} //if
+	} //for
+	OobField_t field;
+	field.type = type;
+	field.data = data;
+	mFields.push_back(field);
+	update_payload_length();
+}
+
+void RecordBluetoothOob::remove_field(uint8_t type) {
+	for (uint32_t i = 0; i < mFields.size(); i++) {
+		if (mFields[i].type == type) {
+			mFields.erase(mFields.begin() + i);
+			update_payload_length();
+			return;
+		} //if
+	} //for
+}
+
+std::string RecordBluetoothOob::get_local_name() const {
+	const std::string *name = get_field(COMPLETE_LOCAL_NAME);
+	if (name == NULL)
+		name = get_field(SHORT_LOCAL_NAME);
+	return name != NULL ? *name : std::string();
+}
+
+void RecordBluetoothOob::set_class_of_device(uint32_t classOfDevice) {
+	//the class of device is written little endian
+	const char data[] = { (char) (classOfDevice & 0xFF),
+			(char) ((classOfDevice >> 8) & 0xFF),
+			(char) ((classOfDevice >> 16) & 0xFF) };
+	set_field(CLASS_OF_DEVICE, std::string(data, sizeof(data)));
+}
+
+bool RecordBluetoothOob::operator==(const RecordBluetoothOob &other) const {
+	if (mTransport != other.mTransport
+			|| std::memcmp(mAddress, other.mAddress, ADDRESS_LENGTH) != 0
+			|| mIsRandomAddress != other.mIsRandomAddress
+			|| get_id() != other.get_id()
+			|| mFields.size() != other.mFields.size())
+		return false;
+	for (uint32_t i = 0; i < mFields.size(); i++) {
+		if (mFields[i].type != other.mFields[i].type
+				|| mFields[i].data != other.mFields[i].data)
+			return false;
+	} //for
+	return true;
+}
+
+void RecordBluetoothOob::update_payload_length() {
+	uint32_t length = mTransport == BR_EDR ?
+			OOB_LENGTH_SIZE + ADDRESS_LENGTH : 2 + LE_ADDRESS_FIELD_LENGTH;
+	for (uint32_t i = 0; i < mFields.size(); i++)
+		//+2 = field length + field type
+		length += 2 + mFields[i].data.size();
+
+	set_generated_data_length(length);
+}
+
+/**
+ * Write the address least significant byte first.
+ */
+static void write_address(uint8_t *buffer, const uint8_t *address) {
+	for (uint8_t i = 0; i < RecordBluetoothOob::ADDRESS_LENGTH; i++)
+		buffer[i] = address[RecordBluetoothOob::ADDRESS_LENGTH - 1 - i];
+}
+
+uint16_t RecordBluetoothOob::write(uint8_t *buffer) {
+	uint16_t offset = mRecordHeader.write_header(buffer);
+	const std::string &mimeType = get_mime_type();
+	std::memcpy(buffer + offset, mimeType.data(), mimeType.size());
+	offset += mimeType.size();
+	offset += write_id(buffer + offset);
+
+	if (mTransport == BR_EDR) {
+		const uint32_t oobLength = get_mime_data_lenght();
+		buffer[offset++] = (uint8_t) (oobLength & 0xFF);
+		buffer[offset++] = (uint8_t) ((oobLength >> 8) & 0xFF);
+		write_address(buffer + offset, mAddress);
+		offset += ADDRESS_LENGTH;
+	} else {
+		buffer[offset++] = 1 + LE_ADDRESS_FIELD_LENGTH;
+		buffer[offset++] = LE_DEVICE_ADDRESS;
+		write_address(buffer + offset, mAddress);
+		offset += ADDRESS_LENGTH;
+		buffer[offset++] = mIsRandomAddress ? 0x01 : 0x00;
+	} //if-else
+
+	for (uint32_t i = 0; i < mFields.size(); i++) {
+		const OobField_t &field = mFields[i];
+		buffer[offset++] = (uint8_t) (1 + field.data.size());
+		buffer[offset++] = field.type;
+		std::memcpy(buffer + offset, field.data.data(), field.data.size());
+		offset += field.data.size();
+	} //for
+
+	return offset;
+}
+
+RecordBluetoothOob* RecordBluetoothOob::parse(const RecordHeader &header,
+		const uint8_t* buffer) {
+	if (header.get_FNT() != RecordHeader::Mime_media_type)
+		return NULL;
+
+	Transport_t transport;
+	if (header.get_type_length() == sBrEdrMimeType.size()
+			&& sBrEdrMimeType.compare(0, sBrEdrMimeType.size(),
+					(const char*) buffer, sBrEdrMimeType.size()) == 0)
+		transport = BR_EDR;
+	else if (header.get_type_length() == sLeMimeType.size()
+			&& sLeMimeType.compare(0, sLeMimeType.size(), (const char*) buffer,
+					sLeMimeType.size()) == 0)
+		transport = LE;
+	else
+		return NULL;
+
+	const uint8_t *payload = buffer + header.get_type_length()
+			+ header.get_id_length();
+	uint32_t length = header.get_payload_length();
+	uint32_t offset = 0;
+
+	uint8_t address[ADDRESS_LENGTH] = { 0 };
+	bool isRandomAddress = false;
+	bool hasAddress = false;
+	if (transport == BR_EDR) {
+		if (length < OOB_LENGTH_SIZE + ADDRESS_LENGTH)
+			return NULL;
+		const uint32_t oobLength = payload[0] | (((uint32_t) payload[1]) << 8);
+		//ignore the data after the declared OOB length
+		if (oobLength < OOB_LENGTH_SIZE + ADDRESS_LENGTH || oobLength > length)
+			return NULL;
+		length = oobLength;
+		for (uint8_t i = 0; i < ADDRESS_LENGTH; i++)
+			address[i] = payload[OOB_LENGTH_SIZE + ADDRESS_LENGTH - 1 - i];
+		offset = OOB_LENGTH_SIZE + ADDRESS_LENGTH;
+		hasAddress = true;
+	} //if
+
+	RecordBluetoothOob *r = new RecordBluetoothOob(transport, address);
+	r->load_id(header, buffer);
+
+	while (offset < length) {
+		const uint8_t fieldLength = payload[offset++];
+		//a 0 length field ends the data
+		if (fieldLength == 0)
+			break;
+		if (length - offset < fieldLength) {
+			delete r;
+			return NULL;
+		} //if
+		const uint8_t type = payload[offset];
+		const uint8_t *data = payload + offset + 1;
+		if (type == LE_DEVICE_ADDRESS) {
+			if (fieldLength != 1 + LE_ADDRESS_FIELD_LENGTH) {
+				delete r;
+				return NULL;
+			} //if
+			for (uint8_t i = 0; i < ADDRESS_LENGTH; i++)
+				address[i] = data[ADDRESS_LENGTH - 1 - i];
+			isRandomAddress = (data[ADDRESS_LENGTH] & 0x01) != 0;
+			hasAddress = true;
+		} else {
+			OobField_t field;
+			field.type = type;
+			field.data.assign((const char*) data, fieldLength - 1);
+			r->mFields.push_back(field);
+		} //if-else
+		offset += fieldLength;
+	} //while
+
+	if (!hasAddress) {
+		delete r;
+		return NULL;
+	} //if
+
+	r->set_device_address(address, isRandomAddress);
+	r->update_payload_length();
+	return r;
+}
+
+} /* namespace NDefLib */
@@ -0,0 +1,253 @@
+/**
+ ******************************************************************************
+ * @file    RecordBluetoothOob.h
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   {@link RecordMimeType} that contains the Bluetooth out of band pairing data
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+#ifndef NDEFLIB_RECORDTYPE_RECORDBLUETOOTHOOB_H_
+#define NDEFLIB_RECORDTYPE_RECORDBLUETOOTHOOB_H_
+
+#include <string>
+#include <vector>
+
+#include "RecordMimeType.h"
+
+namespace NDefLib {
+
+/**
+ * Specialize the {@link RecordMimeType} to store the Bluetooth out of band pairing
+ * data, for Bluetooth BR/EDR (application/vnd.bluetooth.ep.oob) or Bluetooth Low
+ * Energy (application/vnd.bluetooth.le.oob) devices.
+ * @par The record id ({@link Record#set_id}) is the carrier data reference used
+ * by a {@link RecordAlternativeCarrier}.
+ * @par The content is generated directly inside the write buffer, get_mime_data() returns NULL.
+ * @see Bluetooth Secure Simple Pairing Using NFC, NFC Forum application document
+ */
+class RecordBluetoothOob: public RecordMimeType {
+public:
+
+	/**
+	 * Bluetooth transport of the device
+	 */
+	typedef enum {
+		BR_EDR, //!< Bluetooth basic rate / enhanced data rate
+		LE      //!< Bluetooth low energy
+	} Transport_t;
+
+	/**
+	 * Type of the EIR/AD data stored after the device address
+	 */
+	typedef enum {
+		FLAGS = 0x01,                  //!< LE flags
+		INCOMPLETE_16BIT_UUIDS = 0x02, //!< part of the 16 bit service UUIDs
+		COMPLETE_16BIT_UUIDS = 0x03,   //!< all the 16 bit service UUIDs
+		SHORT_LOCAL_NAME = 0x08,       //!< shortened device name
+		COMPLETE_LOCAL_NAME = 0x09,    //!< device name
+		CLASS_OF_DEVICE = 0x0D,        //!< 3 bytes class of device
+		SIMPLE_PAIRING_HASH = 0x0E,    //!< 16 bytes hash C
+		SIMPLE_PAIRING_RANDOMIZER = 0x0F, //!< 16 bytes randomizer R
+		SECURITY_MANAGER_TK = 0x10,    //!< 16 bytes LE temporary key
+		APPEARANCE = 0x19,             //!< 2 bytes LE appearance
+		LE_DEVICE_ADDRESS = 0x1B,      //!< LE address, written from the device address
+		LE_ROLE = 0x1C,                //!< 1 byte LE role
+		LE_SC_CONFIRMATION = 0x22,     //!< 16 bytes LE secure connections confirmation
+		LE_SC_RANDOM = 0x23            //!< 16 bytes LE secure connections random
+	} OobDataType_t;
+
+	/**
+	 * LE role values
+	 */
+	typedef enum {
+		LE_ROLE_PERIPHERAL = 0x00,           //!< only peripheral
+		LE_ROLE_CENTRAL = 0x01,              //!< only central
+		LE_ROLE_PERIPHERAL_PREFERRED = 0x02, //!< both, peripheral preferred
+		LE_ROLE_CENTRAL_PREFERRED = 0x03     //!< both, central preferred
+	} LeRole_t;
+
+	/**
+	 * Number of bytes of a Bluetooth device address.
+	 */
+	static const uint8_t ADDRESS_LENGTH = 6;
+
+	/**
+	 * Create a RecordBluetoothOob reading the data from the buffer.
+ 	 * @param header Record header.
+	 * @param buffer Buffer to read the data from.
+	 * @return an object of type RecordBluetoothOob or NULL
+	 * @par User is in charge of freeing the pointer returned by this function.
+	 */
+	static RecordBluetoothOob* parse(const RecordHeader &header,
+			const uint8_t* buffer);
+
+	/**
+	 * Create a record with the device address.
+	 * @param transport Bluetooth transport.
+	 * @param address Device address, ADDRESS_LENGTH bytes, most significant byte first.
+	 * @param isRandomAddress True if it is a LE random address.
+	 */
+	RecordBluetoothOob(Transport_t transport,const uint8_t *address,
+			bool isRandomAddress=false);
+
+    /**
+     * Get the record type.
+     * @return TYPE_MIME_BLUETOOTH_OOB
+	 */
+	virtual RecordType_t get_type() const {
+		return TYPE_MIME_BLUETOOTH_OOB;
+	} //getType
+
+	/**
+	 * @return Bluetooth transport of the device
+	 */
+	Transport_t get_transport() const {
+		return mTransport;
+	}
+
+	/**
+	 * @return device address, ADDRESS_LENGTH bytes, most significant byte first
+	 */
+	const uint8_t* get_device_address() const {
+		return mAddress;
+	}
+
+	/**
+	 * @return true if the device uses a LE random address
+	 */
+	bool is_random_address() const {
+		return mIsRandomAddress;
+	}
+
+	/**
+	 * Change the device address.
+	 * @param address Device address, ADDRESS_LENGTH bytes, most significant byte first.
+	 * @param isRandomAddress True if it is a LE random address.
+	 */
+	void set_device_address(const uint8_t *address,bool isRandomAddress=false){
+		std::memcpy(mAddress,address,ADDRESS_LENGTH);
+		mIsRandomAddress=isRandomAddress;
+	}
+
+	/**
+	 * Get a EIR/AD data.
+	 * @param type data type
+	 * @return data content or NULL if the record doesn't contain the data
+	 */
+	const std::string* get_field(uint8_t type) const;
+
+	/**
+	 * Add or replace a EIR/AD data.
+	 * @param type data type
+	 * @param data data content, at most 254 bytes
+	 * @par The device address is written by the record, LE_DEVICE_ADDRESS is ignored.
+	 */
+	void set_field(uint8_t type,const std::string &data);
+
+	/**
+	 * Remove a EIR/AD data.
+	 * @param type data type
+	 */
+	void remove_field(uint8_t type);
+
+	/**
+	 * Get the device name.
+	 * @return complete or shortened name, an empty string if not present
+	 */
+	std::string get_local_name() const;
+
+	/**
+	 * Change the device name.
+	 * @param name complete device name
+	 */
+	void set_local_name(const std::string &name){
+		set_field(COMPLETE_LOCAL_NAME,name);
+	}
+
+	/**
+	 * Change the class of device.
+	 * @param classOfDevice 24 bit class of device
+	 */
+	void set_class_of_device(uint32_t classOfDevice);
+
+	/**
+	 * Change the LE role.
+	 * @param role device role
+	 */
+	void set_le_role(LeRole_t role){
+		set_field(LE_ROLE,std::string(1,(char)role));
+	}
+
+	/**
+	 * Write the record header, the id and the pairing data on the buffer.
+	 * @param[out] buffer buffer to write the record content into.
+	 * @return number of bytes written
+	 * @see Record#write
+	 */
+	virtual uint16_t write(uint8_t *buffer);
+
+	/**
+	 * Compare two objects.
+	 * @return true if the records have the same transport, address, id and data
+	 */
+	bool operator==(const RecordBluetoothOob &other) const;
+
+	virtual ~RecordBluetoothOob(){ }
+
+private:
+
+	/**
+	 * EIR/AD data
+	 */
+	typedef struct {
+		uint8_t type;
+		std::string data;
+	} OobField_t;
+
+	/**
+	 * Compute the payload length and update the record header, it is called
+	 * every time the fields change so write doesn't need to compute it again.
+	 */
+	void update_payload_length();
+
+	const Transport_t mTransport;
+	uint8_t mAddress[ADDRESS_LENGTH];
+	bool mIsRandomAddress;
+	std::vector<OobField_t> mFields;
+
+	static const std::string sBrEdrMimeType;
+	static const std::string sLeMimeType;
+};
+
+} /* namespace NDefLib */
+
+#endif /* NDEFLIB_RECORDTYPE_RECORDBLUETOOTHOOB_H_ */
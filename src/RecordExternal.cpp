@@ -0,0 +1,113 @@
+/**
+ ******************************************************************************
+ * @file    RecordExternal.cpp
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   RecordExternal implementation.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+#include "RecordExternal.h"
+
+namespace NDefLib {
+
+RecordExternal::DecoderEntry_t RecordExternal::sDecoders[NDEF_MAX_EXTERNAL_DECODERS] = { };
+
+/**
+ * Convert a char to lower case.
+ */
+static char to_lower(const char c) {
+	return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+}
+
+uint8_t RecordExternal::find_decoder(const char *type, uint8_t typeLength) {
+	for (uint8_t i = 0; i < NDEF_MAX_EXTERNAL_DECODERS; i++) {
+		const char *registeredType = sDecoders[i].type;
+		if (registeredType == NULL)
+			continue;
+		uint8_t j = 0;
+		while (j < typeLength && registeredType[j] != '\0'
+				&& to_lower(registeredType[j]) == to_lower(type[j]))
+			j++;
+		if (j == typeLength && registeredType[j] == '\0')
+			return i;
+	} //for
+	return NDEF_MAX_EXTERNAL_DECODERS;
+}
+
+bool RecordExternal::register_decoder(const char *type,
+		ExternalDecoder_t decoder) {
+	const std::size_t typeLength = std::strlen(type);
+	if (typeLength > 0xFF)
+		return false;
+	uint8_t index = find_decoder(type, typeLength);
+	if (index == NDEF_MAX_EXTERNAL_DECODERS) {
+		//search a free slot
+		for (index = 0; index < NDEF_MAX_EXTERNAL_DECODERS; index++) {
+			if (sDecoders[index].type == NULL)
+				break;
+		} //for
+		if (index == NDEF_MAX_EXTERNAL_DECODERS)
+			return false;
+	} //if
+	sDecoders[index].type = type;
+	sDecoders[index].decoder = decoder;
+	return true;
+}
+
+void RecordExternal::unregister_decoder(const char *type) {
+	const uint8_t index = find_decoder(type, std::strlen(type));
+	if (index != NDEF_MAX_EXTERNAL_DECODERS) {
+		sDecoders[index].type = NULL;
+		sDecoders[index].decoder = NULL;
+	} //if
+}
+
+Record* RecordExternal::parse(const RecordHeader &header,
+		const uint8_t *buffer) {
+	if (header.get_FNT() != RecordHeader::NFC_external)
+		return NULL;
+
+	const char *type = (const char*) buffer;
+	const uint8_t *payload = buffer + header.get_type_length()
+			+ header.get_id_length();
+
+	const uint8_t index = find_decoder(type, header.get_type_length());
+	if (index != NDEF_MAX_EXTERNAL_DECODERS) {
+		Record *r = sDecoders[index].decoder(header, payload);
+		if (r != NULL)
+			return r;
+	} //if
+
+	return new RecordExternal(std::string(type, header.get_type_length()),
+			payload, header.get_payload_length());
+}
+
+} /* namespace NDefLib */
@@ -0,0 +1,158 @@
+/**
+ ******************************************************************************
+ * @file    RecordExternal.h
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   NFC Forum external type record
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+#ifndef NDEFLIB_RECORDTYPE_RECORDEXTERNAL_H_
+#define NDEFLIB_RECORDTYPE_RECORDEXTERNAL_H_
+
+#include "RecordBinary.h"
+
+/**
+ * Maximum number of decoders that can be registered for the external types.
+ */
+#ifndef NDEF_MAX_EXTERNAL_DECODERS
+#define NDEF_MAX_EXTERNAL_DECODERS 8
+#endif
+
+namespace NDefLib {
+
+/**
+ * NFC Forum external type record, the record type has the form domain:type.
+ * @par A decoder can be registered for a domain:type string, so that
+ * {@link Message#parse_message} builds a specific record for it.
+ * @see NFC Record Type Definition (RTD) Technical Specification
+ */
+class RecordExternal: public RecordBinary {
+public:
+
+	/**
+	 * Function that builds a record from an external type record.
+	 * @param header Record header.
+	 * @param payload Record payload, {@link RecordHeader#get_payload_length} bytes.
+	 * @return record or NULL if the payload is not valid, in this case a
+	 * RecordExternal is built
+	 * @par The returned record is freed by the user.
+	 */
+	typedef Record* (*ExternalDecoder_t)(const RecordHeader &header,
+			const uint8_t *payload);
+
+	/**
+	 * Create a record reading the data from the buffer.
+ 	 * @param header Record header.
+	 * @param buffer Buffer to read the data from.
+	 * @return the record built by the decoder registered for the type, a
+	 * RecordExternal if there is not a decoder, NULL if it is not an external type record
+	 * @par User is in charge of freeing the pointer returned by this function.
+	 */
+	static Record* parse(const RecordHeader &header, const uint8_t *buffer);
+
+	/**
+	 * Register a decoder for an external type.
+	 * @param type domain:type string, it is compared ignoring the case. The string is
+	 * not copied, so it must be valid until the decoder is unregistered.
+	 * @param decoder function to call to build the record.
+	 * @return false if NDEF_MAX_EXTERNAL_DECODERS decoders are already registered
+	 * @par A decoder registered again for the same type replaces the previous one.
+	 */
+	static bool register_decoder(const char *type, ExternalDecoder_t decoder);
+
+	/**
+	 * Remove the decoder of an external type.
+	 * @param type domain:type string.
+	 */
+	static void unregister_decoder(const char *type);
+
+	/**
+	 * Create a new record.
+	 * @param type domain:type string.
+	 * @param data Payload, it is copied inside the class.
+	 * @param dataLength Payload length in bytes.
+	 */
+	explicit RecordExternal(const std::string &type, const uint8_t *data=NULL,
+			uint32_t dataLength=0):
+		RecordBinary(RecordHeader::NFC_external,type,data,dataLength){ }
+
+    /**
+     * Get the record type.
+     * @return TYPE_EXTERNAL
+	 */
+	virtual RecordType_t get_type() const {
+		return TYPE_EXTERNAL;
+	} //getType
+
+	/**
+	 * @return domain part of the record type
+	 */
+	std::string get_domain() const {
+		const std::string &type = get_type_string();
+		return type.substr(0,type.find(':'));
+	}
+
+	/**
+	 * @return type part of the record type, after the domain
+	 */
+	std::string get_external_type() const {
+		const std::string &type = get_type_string();
+		const std::size_t separator = type.find(':');
+		return separator==std::string::npos ? std::string() : type.substr(separator+1);
+	}
+
+	virtual ~RecordExternal() { }
+
+private:
+
+	/**
+	 * Registered decoder
+	 */
+	typedef struct {
+		const char *type;
+		ExternalDecoder_t decoder;
+	} DecoderEntry_t;
+
+	/**
+	 * Search the decoder registered for a type.
+	 * @param type record type.
+	 * @param typeLength record type length.
+	 * @return index of the decoder or NDEF_MAX_EXTERNAL_DECODERS if not found
+	 */
+	static uint8_t find_decoder(const char *type, uint8_t typeLength);
+
+	static DecoderEntry_t sDecoders[NDEF_MAX_EXTERNAL_DECODERS];
+};
+
+} /* namespace NDefLib */
+
+#endif /* NDEFLIB_RECORDTYPE_RECORDEXTERNAL_H_ */
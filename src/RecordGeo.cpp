@@ -34,7 +34,7 @@
  *
  ******************************************************************************
  */
-#include <cstdio>
+#include <cstring>
 
 #include "RecordGeo.h"
 
@@ -42,55 +42,363 @@ namespace NDefLib {
 
 const std::string RecordGeo::sGeoTag = ("geo:");
 
-//number of digits used for print the coordintate
-#define N_FLOAT_DIGIS 4
-#define N_INTEGER_DIGIS 3
-//string with the 2 coordinate format
-#define COORDINATE_WRITE_FORMAT "%3.4f,%3.4f"
-//+1 = sign, +1 = .
-#define COORDINATE_STR_SIZE (1+N_INTEGER_DIGIS+1+N_FLOAT_DIGIS)
+//number of decimal digits stored for a coordinate
+#define COORDINATE_DECIMALS 7
+//number of decimal digits stored for the altitude and the uncertainty (cm)
+#define METER_DECIMALS 2
+//coordinate limits in degrees, checked by parse
+#define MAX_LATITUDE 90
+#define MAX_LONGITUDE 180
+//largest magnitude of a fixed point value, the same limit used by parse_fixed
+#define MAX_FIXED 0x7FFFFFFF
+//uncertainty parameter name
+#define UNCERTAINTY_PARAM "u="
+#define UNCERTAINTY_PARAM_LENGTH (sizeof(UNCERTAINTY_PARAM)-1)
+//sign + 10 digits + . = max length of a formatted int32
+#define FIXED_STR_SIZE (1+10+1)
+//3 values + 2 separators + ;u= + the uncertainty
+#define GEO_STR_SIZE (3*FIXED_STR_SIZE+2+1+UNCERTAINTY_PARAM_LENGTH+FIXED_STR_SIZE)
 
-//string to use for read a couple of coordinate
-#define COORDINATE_READ_FORMAT "%f,%f"
+static const uint32_t sPow10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000,
+		10000000 };
 
+/**
+ * Convert a float in a fixed point value, rounding to the nearest.
+ * @par Out of range values are clamped and NaN is converted to 0, so the
+ * written record can always be parsed back.
+ * @param value Value to convert.
+ * @param nDecimals Number of decimal digits of the fixed point value.
+ * @param maxFixed Largest magnitude of the fixed point value.
+ * @return fixed point value
+ */
+static int32_t to_fixed(const float value, const uint8_t nDecimals,
+		const int32_t maxFixed = MAX_FIXED) {
+	if (value != value)
+		return 0;
+	//double keeps the rounded value exact in the int32 range
+	const double scaled = (double) value * sPow10[nDecimals];
+	const double rounded = scaled < 0 ? scaled - 0.5 : scaled + 0.5;
+	if (rounded >= maxFixed)
+		return maxFixed;
+	if (rounded <= -maxFixed)
+		return -maxFixed;
+	return (int32_t) rounded;
+}
+
+/**
+ * @param lat Latitude in degrees.
+ * @return latitude as fixed point value, clamped to +-MAX_LATITUDE
+ */
+static int32_t latitude_to_fixed(const float lat) {
+	return to_fixed(lat, COORDINATE_DECIMALS,
+			MAX_LATITUDE * (int32_t) sPow10[COORDINATE_DECIMALS]);
+}
+
+/**
+ * @param lon Longitude in degrees.
+ * @return longitude as fixed point value, clamped to +-MAX_LONGITUDE
+ */
+static int32_t longitude_to_fixed(const float lon) {
+	return to_fixed(lon, COORDINATE_DECIMALS,
+			MAX_LONGITUDE * (int32_t) sPow10[COORDINATE_DECIMALS]);
+}
+
+/**
+ * Print a fixed point value as a decimal number.
+ * @param out Buffer where write the number.
+ * @param value Fixed point value.
+ * @param nDecimals Number of decimal digits of the fixed point value.
+ * @param nPrintDecimals Number of decimal digits to print, the value is rounded.
+ * @param trimZeros True to remove the trailing zeros of the decimal part.
+ * @return number of written chars
+ */
+static uint8_t format_fixed(char *out, const int32_t value,
+		const uint8_t nDecimals, uint8_t nPrintDecimals, const bool trimZeros) {
+	uint32_t magnitude = value < 0 ? -(uint32_t) value : (uint32_t) value;
+
+	if (nPrintDecimals < nDecimals) {
+		const uint32_t div = sPow10[nDecimals - nPrintDecimals];
+		magnitude = magnitude / div + (magnitude % div >= div / 2 ? 1 : 0);
+	}
+
+	uint32_t decimals = magnitude % sPow10[nPrintDecimals];
+	uint32_t integer = magnitude / sPow10[nPrintDecimals];
+	if (trimZeros) {
+		while (nPrintDecimals > 0 && decimals % 10 == 0) {
+			decimals /= 10;
+			nPrintDecimals--;
+		} //while
+	} //if
+
+	uint8_t length = 0;
+	if (value < 0 && magnitude != 0)
+		out[length++] = '-';
+
+	//write the integer part in reverse order and flip it
+	const uint8_t integerStart = length;
+	do {
+		out[length++] = '0' + integer % 10;
+		integer /= 10;
+	} while (integer != 0);
+	for (uint8_t i = integerStart, j = length - 1; i < j; i++, j--) {
+		const char temp = out[i];
+		out[i] = out[j];
+		out[j] = temp;
+	} //for
+
+	if (nPrintDecimals != 0) {
+		out[length++] = '.';
+		for (uint8_t i = nPrintDecimals; i > 0; i--) {
+			out[length + i - 1] = '0' + decimals % 10;
+			decimals /= 10;
+		} //for
+		length += nPrintDecimals;
+	} //if
+
+	return length;
+}
+
+/**
+ * Read a decimal number as a fixed point value.
+ * @param str String to read.
+ * @param length Number of chars available in the string.
+ * @param nDecimals Number of decimal digits of the fixed point value, extra
+ * digits are rounded.
+ * @param[out] value Read value.
+ * @param[out] readDecimals Number of decimal digits present in the string, can be NULL.
+ * @return number of read chars, 0 if the string doesn't start with a valid number
+ */
+static uint16_t parse_fixed(const char *str, const uint16_t length,
+		const uint8_t nDecimals, int32_t *value, uint8_t *readDecimals) {
+	uint16_t offset = 0;
+	const bool isNegative = length != 0 && str[0] == '-';
+	if (isNegative)
+		offset++;
+
+	uint32_t magnitude = 0;
+	const uint32_t maxMagnitude = 0x7FFFFFFF;
+	uint8_t nIntegerDigits = 0;
+	while (offset < length && str[offset] >= '0' && str[offset] <= '9') {
+		const uint8_t digit = str[offset++] - '0';
+		if (magnitude > (maxMagnitude - digit) / 10)
+			return 0;
+		magnitude = magnitude * 10 + digit;
+		nIntegerDigits++;
+	} //while
+	if (nIntegerDigits == 0)
+		return 0;
+	if (magnitude > maxMagnitude / sPow10[nDecimals])
+		return 0;
+	magnitude *= sPow10[nDecimals];
+
+	uint8_t nReadDecimals = 0;
+	if (offset < length && str[offset] == '.') {
+		offset++;
+		while (offset < length && str[offset] >= '0' && str[offset] <= '9') {
+			const uint8_t digit = str[offset++] - '0';
+			if (nReadDecimals < nDecimals)
+				magnitude += digit * sPow10[nDecimals - nReadDecimals - 1];
+			else if (nReadDecimals == nDecimals && digit >= 5)
+				magnitude++;
+			nReadDecimals++;
+		} //while
+		if (nReadDecimals == 0)
+			return 0;
+		if (magnitude > maxMagnitude)
+			return 0;
+	} //if
+
+	*value = isNegative ? -(int32_t) magnitude : (int32_t) magnitude;
+	if (readDecimals != NULL)
+		*readDecimals = nReadDecimals;
+	return offset;
+}
+
+/**
+ * Compare a string with a lower case string, ignoring the case.
+ * @return true if str starts with lowerStr
+ */
+static bool starts_with_ignore_case(const char *str, const uint16_t length,
+		const char *lowerStr, const uint16_t lowerLength) {
+	if (length < lowerLength)
+		return false;
+	for (uint16_t i = 0; i < lowerLength; i++) {
+		char c = str[i];
+		if (c >= 'A' && c <= 'Z')
+			c += 'a' - 'A';
+		if (c != lowerStr[i])
+			return false;
+	} //for
+	return true;
+}
 
 RecordGeo::RecordGeo(const float lat, const float lon) :
-		RecordURI(sGeoTag), mLatitiude(lat), mLongitude(lon),mContentIsChange(true) {
+		RecordURI(sGeoTag), mLatitiude(latitude_to_fixed(lat)),
+		mLongitude(longitude_to_fixed(lon)), mAltitude(0),
+		mUncertainty(0), mHasAltitude(false), mHasUncertainty(false),
+		mPrecision(DEFAULT_PRECISION), mContentIsChange(true) {
 };
 
+float RecordGeo::get_latitude() const {
+	return mLatitiude / (float) sPow10[COORDINATE_DECIMALS];
+}
+
+float RecordGeo::get_longitude() const {
+	return mLongitude / (float) sPow10[COORDINATE_DECIMALS];
+}
+
+float RecordGeo::get_altitude() const {
+	return mAltitude / (float) sPow10[METER_DECIMALS];
+}
+
+float RecordGeo::get_uncertainty() const {
+	return mUncertainty / (float) sPow10[METER_DECIMALS];
+}
+
+void RecordGeo::set_latitude(const float lat) {
+	mContentIsChange = true;
+	mLatitiude = latitude_to_fixed(lat);
+}
+
+void RecordGeo::set_longitude(const float lon) {
+	mContentIsChange = true;
+	mLongitude = longitude_to_fixed(lon);
+}
+
+void RecordGeo::set_altitude(const float alt) {
+	mContentIsChange = true;
+	mHasAltitude = true;
+	mAltitude = to_fixed(alt, METER_DECIMALS);
+}
+
+void RecordGeo::set_uncertainty(const float uncertainty) {
+	mContentIsChange = true;
+	mHasUncertainty = true;
+	mUncertainty = to_fixed(uncertainty < 0 ? 0 : uncertainty, METER_DECIMALS);
+}
+
+void RecordGeo::set_precision(const uint8_t nDecimals) {
+	mContentIsChange = true;
+	mPrecision = nDecimals;
+	if (mPrecision > MAX_PRECISION)
+		mPrecision = MAX_PRECISION;
+}
+
 void RecordGeo::update_content(){
 	if(!mContentIsChange)
 		return;
 
-	//2 coordinate +1 for the separator +1 for the \0
-	char buffer[2*COORDINATE_STR_SIZE+1+1];
-	std::sprintf(buffer,COORDINATE_WRITE_FORMAT,mLatitiude,mLongitude);
-	mContent.clear();
-	mContent.append(buffer);
+	char buffer[GEO_STR_SIZE];
+	uint8_t length = format_fixed(buffer, mLatitiude, COORDINATE_DECIMALS,
+			mPrecision, false);
+	buffer[length++] = ',';
+	length += format_fixed(buffer + length, mLongitude, COORDINATE_DECIMALS,
+			mPrecision, false);
+	if (mHasAltitude) {
+		buffer[length++] = ',';
+		length += format_fixed(buffer + length, mAltitude, METER_DECIMALS,
+				METER_DECIMALS, true);
+	} //if
+	if (mHasUncertainty) {
+		buffer[length++] = ';';
+		std::memcpy(buffer + length, UNCERTAINTY_PARAM, UNCERTAINTY_PARAM_LENGTH);
+		length += UNCERTAINTY_PARAM_LENGTH;
+		length += format_fixed(buffer + length, mUncertainty, METER_DECIMALS,
+				METER_DECIMALS, true);
+	} //if
+
+	//reuse the string storage
+	mContent.assign(buffer, length);
 
 	mContentIsChange=false;
 }
 
 RecordGeo* RecordGeo::parse(const RecordHeader &header,
 		const uint8_t * const buffer) {
-	uint16_t offset = 0;
-	if (buffer[offset++] != RecordURI::sNDEFUriIdCode)
+	if (buffer[0] != RecordURI::sNDEFUriIdCode)
 		return NULL;
-	if (buffer[offset++] != RecordURI::UNKNOWN)
+	if (header.get_payload_length() < 1 + sGeoTag.size())
+		return NULL;
+	//the payload starts after the record type and id
+	const uint8_t *payload = buffer + 1 + header.get_id_length();
+	uint16_t offset = 0;
+	if (payload[offset++] != RecordURI::UNKNOWN)
 		return NULL;
-	if (sGeoTag.compare(0, sGeoTag.size(), (const char*) buffer + offset,
+	if (sGeoTag.compare(0, sGeoTag.size(), (const char*) payload + offset,
 			sGeoTag.size()) != 0)
 		return NULL;
 	offset += sGeoTag.size();
 
-	const std::string uriContent((const char*) (buffer + offset),
-			header.get_payload_length() - offset);
+	const char *uri = (const char*) payload + offset;
+	const uint16_t length = header.get_payload_length() - offset;
+	uint16_t index = 0;
 
-	float lat,lon;
+	int32_t lat, lon, alt = 0;
+	uint8_t latDecimals, lonDecimals;
+	uint16_t nRead = parse_fixed(uri, length, COORDINATE_DECIMALS, &lat,
+			&latDecimals);
+	if (nRead == 0)
+		return NULL;
+	index += nRead;
 	//build the record only if both the coordinate are available
-	if(std::sscanf(uriContent.c_str(),COORDINATE_READ_FORMAT,&lat,&lon)!=2)
+	if (index == length || uri[index++] != ',')
+		return NULL;
+	nRead = parse_fixed(uri + index, length - index, COORDINATE_DECIMALS, &lon,
+			&lonDecimals);
+	if (nRead == 0)
+		return NULL;
+	index += nRead;
+
+	const int32_t maxLat = MAX_LATITUDE * (int32_t) sPow10[COORDINATE_DECIMALS];
+	const int32_t maxLon = MAX_LONGITUDE * (int32_t) sPow10[COORDINATE_DECIMALS];
+	if (lat > maxLat || lat < -maxLat || lon > maxLon || lon < -maxLon)
 		return NULL;
-	return new RecordGeo(lat,lon);
+
+	const bool hasAltitude = index < length && uri[index] == ',';
+	if (hasAltitude) {
+		index++;
+		nRead = parse_fixed(uri + index, length - index, METER_DECIMALS, &alt,
+				NULL);
+		if (nRead == 0)
+			return NULL;
+		index += nRead;
+	} //if
+
+	//parameters: only the uncertainty is kept, the others are ignored
+	int32_t uncertainty = 0;
+	bool hasUncertainty = false;
+	while (index < length) {
+		if (uri[index++] != ';')
+			return NULL;
+		if (starts_with_ignore_case(uri + index, length - index,
+				UNCERTAINTY_PARAM, UNCERTAINTY_PARAM_LENGTH)) {
+			index += UNCERTAINTY_PARAM_LENGTH;
+			nRead = parse_fixed(uri + index, length - index, METER_DECIMALS,
+					&uncertainty, NULL);
+			if (nRead == 0 || uncertainty < 0)
+				return NULL;
+			index += nRead;
+			hasUncertainty = true;
+		} else {
+			while (index < length && uri[index] != ';')
+				index++;
+		} //if-else
+	} //while
+
+	RecordGeo *r = new RecordGeo(0, 0);
+	//keep the original content until the user changes a value
+	r->mContent.assign(uri, length);
+	r->mContentIsChange = false;
+	r->mLatitiude = lat;
+	r->mLongitude = lon;
+	r->mAltitude = alt;
+	r->mHasAltitude = hasAltitude;
+	r->mUncertainty = uncertainty;
+	r->mHasUncertainty = hasUncertainty;
+	//keep the precision used by the writer
+	r->set_precision(latDecimals > lonDecimals ? latDecimals : lonDecimals);
+	r->mContentIsChange = false;
+	return r;
 
 }
 
@@ -45,8 +45,12 @@ namespace NDefLib {
 
 /**
  * Specialize the {@link RecordUri} to handle a location position, the location
- * is stored with latitude and longitude.
- * @par The coordinates are floats with 4 decimal positions.
+ * is stored with latitude, longitude and optionally altitude and uncertainty (RFC 5870).
+ * @par The coordinates are stored as fixed point values with 7 decimal positions
+ * and written with 4 decimal positions by default, altitude and uncertainty are
+ * stored in centimeters.
+ * @par A parsed record keeps the tag content until a value is changed, then
+ * the content is rebuilt and the URI parameters other than u= are dropped.
  */
 class RecordGeo: public RecordURI {
 public:
@@ -64,45 +68,119 @@ public:
 
 	/**
 	 * Create a record that contains a gps coordinate.
-	 * @param lat Latitude.
-	 * @param lon Longitude.
+	 * @param lat Latitude, clamped to [-90, 90].
+	 * @param lon Longitude, clamped to [-180, 180].
 	 */
 	RecordGeo(const float lat, const float lon);
 
 	virtual ~RecordGeo() { };
 
+	/**
+	 * Maximum number of decimal positions used to write the coordinates.
+	 */
+	static const uint8_t MAX_PRECISION = 7;
+
+	/**
+	 * Default number of decimal positions used to write the coordinates.
+	 */
+	static const uint8_t DEFAULT_PRECISION = 4;
+
 	/**
 	 * Return the longitude coordinate
 	 * @return the longitude coordinate
 	 */
-	float get_longitude()const {
-		return mLongitude;
-	}
+	float get_longitude()const;
 
 	/**
 	 * Return the latitude coordinate
 	 * @return the latitude coordinate
 	 */
-	float get_latitude()const {
-		return mLatitiude;
+	float get_latitude()const;
+
+	/**
+	 * Return the altitude.
+	 * @return altitude in meters, 0 if it is not present
+	 */
+	float get_altitude()const;
+
+	/**
+	 * Return the location uncertainty.
+	 * @return uncertainty in meters, 0 if it is not present
+	 */
+	float get_uncertainty()const;
+
+	/**
+	 * Tell if the record contains the altitude.
+	 * @return true if the altitude is present
+	 */
+	bool has_altitude()const {
+		return mHasAltitude;
+	}
+
+	/**
+	 * Tell if the record contains the location uncertainty.
+	 * @return true if the uncertainty is present
+	 */
+	bool has_uncertainty()const {
+		return mHasUncertainty;
 	}
 
 	/**
 	 * Change the latitude coordinate.
-	 * @param lat new latitude.
+	 * @param lat new latitude, clamped to [-90, 90].
+	 */
+	void set_latitude(const float lat);
+
+	/**
+	 * Change the longitude coordinate.
+	 * @param lon new longitude, clamped to [-180, 180].
+	 */
+	void set_longitude(const float lon);
+
+	/**
+	 * Change the altitude, the altitude will be written in the record.
+	 * @param alt new altitude in meters, clamped to about +-21474 km.
+	 */
+	void set_altitude(const float alt);
+
+	/**
+	 * Remove the altitude from the record.
 	 */
-	void set_latitude(const float lat){
+	void remove_altitude(){
 		mContentIsChange=true;
-		mLatitiude=lat;
+		mHasAltitude=false;
+		mAltitude=0;
 	}
 
-    /**
-	 * Change the longitude coordinate.
-	 * @param lon new longitude
+	/**
+	 * Change the location uncertainty, it will be written as u= parameter.
+	 * @param uncertainty new uncertainty in meters, negative values are written as 0,
+	 * values above about 21474 km are clamped.
 	 */
-	void set_longitude(const float lon){
+	void set_uncertainty(const float uncertainty);
+
+	/**
+	 * Remove the uncertainty from the record.
+	 */
+	void remove_uncertainty(){
 		mContentIsChange=true;
-		mLongitude=lon;
+		mHasUncertainty=false;
+		mUncertainty=0;
+	}
+
+	/**
+	 * Change the number of decimal positions used to write the coordinates.
+	 * @param nDecimals Number of decimal positions, at most MAX_PRECISION.
+	 */
+	void set_precision(const uint8_t nDecimals);
+
+	/**
+	 * Return the number of decimal positions used to write the coordinates.
+	 * @return number of decimal positions
+	 * @par For a parsed record it is the number of decimal positions present in the tag.
+	 */
+	uint8_t get_precision()const {
+		return mPrecision;
 	}
 
     /**
@@ -115,11 +193,15 @@ public:
 
     /**
      * Compare two RecordGeo tags.
-     * @return true if the two tags have the same latitude and longitude
+     * @return true if the two tags have the same position and uncertainty
      */
 	bool operator==(const RecordGeo &other) const {
 		return 	(mLatitiude == other.mLatitiude) &&
-				(mLongitude == other.mLongitude) ;
+				(mLongitude == other.mLongitude) &&
+				(mHasAltitude == other.mHasAltitude) &&
+				(mAltitude == other.mAltitude) &&
+				(mHasUncertainty == other.mHasUncertainty) &&
+				(mUncertainty == other.mUncertainty);
 	}
 
 protected:
@@ -132,14 +214,39 @@ protected:
 private:
 
     /**
-     * Latitude information.
+     * Latitude information, in 1e-7 degrees.
      */
-	float mLatitiude;
+	int32_t mLatitiude;
+
+	/**
+	 * Longitude information, in 1e-7 degrees.
+	 */
+	int32_t mLongitude;
+
+	/**
+	 * Altitude, in centimeters.
+	 */
+	int32_t mAltitude;
+
+	/**
+	 * Location uncertainty, in centimeters.
+	 */
+	int32_t mUncertainty;
+
+	/**
+	 * True if the altitude is written in the record.
+	 */
+	bool mHasAltitude;
+
+	/**
+	 * True if the uncertainty is written in the record.
+	 */
+	bool mHasUncertainty;
 
 	/**
-	 * Longitude information.
+	 * Number of decimal positions used to write the coordinates.
 	 */
-	float mLongitude;
+	uint8_t mPrecision;
 
     /**
      * True if the user has updated the latitude or longitude.
@@ -0,0 +1,258 @@
+/**
+ ******************************************************************************
+ * @file    RecordHandover.cpp
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   RecordHandover implementation.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+#include <cstring>
+#include "RecordHandover.h"
+
+namespace NDefLib {
+
+const char RecordHandover::sSelectRecordType[] = { 'H', 's' };
+const char RecordHandover::sRequestRecordType[] = { 'H', 'r' };
+const char RecordHandover::sCollisionRecordType[] = { 'c', 'r' };
+const char RecordHandover::sErrorRecordType[] = { 'e', 'r', 'r' };
+
+//size of the random number in the collision resolution record
+#define COLLISION_RESOLUTION_LENGTH 2
+
+RecordHandover::RecordHandover(HandoverType_t type, uint8_t version) :
+		mHandoverType(type), mVersion(version), mCollisionResolution(0),
+		mErrorReason(0) {
+	mRecordHeader.set_FNT(RecordHeader::NFC_well_known);
+	mRecordHeader.set_type_length(sizeof(sSelectRecordType));
+	update_payload_length();
+}
+
+RecordHandover::~RecordHandover() {
+	for (uint32_t i = 0; i < mOtherRecords.size(); i++)
+		delete mOtherRecords[i];
+}
+
+bool RecordHandover::same_other_records(const RecordHandover &other) const {
+	if (mOtherRecords.size() != other.mOtherRecords.size())
+		return false;
+	for (uint32_t i = 0; i < mOtherRecords.size(); i++)
+		if (!(*mOtherRecords[i] == *other.mOtherRecords[i]))
+			return false;
+	return true;
+}
+
+/**
+ * Build the header of a record inside the nested message.
+ * @param typeLength Record type length.
+ * @param payloadLength Record payload length.
+ * @return record header
+ */
+static RecordHeader build_nested_header(const uint8_t typeLength,
+		const uint32_t payloadLength) {
+	RecordHeader header;
+	header.set_FNT(RecordHeader::NFC_well_known);
+	header.set_type_length(typeLength);
+	header.set_payload_length(payloadLength);
+	return header;
+}
+
+void RecordHandover::update_payload_length() {
+	//version
+	uint32_t length = 1;
+	if (has_collision_resolution())
+		length += build_nested_header(sizeof(sCollisionRecordType),
+				COLLISION_RESOLUTION_LENGTH).get_record_length();
+	for (uint32_t i = 0; i < mAlternativeCarriers.size(); i++)
+		length += mAlternativeCarriers[i].get_byte_length();
+	if (mErrorReason != 0)
+		length += build_nested_header(sizeof(sErrorRecordType),
+				1 + mErrorData.size()).get_record_length();
+	for (uint32_t i = 0; i < mOtherRecords.size(); i++)
+		length += mOtherRecords[i]->get_byte_length();
+	mRecordHeader.set_payload_length(length);
+}
+
+/**
+ * Write the header and the type of a record inside the nested message.
+ * @return number of bytes written
+ */
+static uint16_t write_nested_header(uint8_t *buffer, RecordHeader header,
+		const char *type, const bool isFirst, const bool isLast) {
+	header.set_MB(isFirst);
+	header.set_ME(isLast);
+	uint16_t offset = header.write_header(buffer);
+	std::memcpy(buffer + offset, type, header.get_type_length());
+	return offset + header.get_type_length();
+}
+
+uint16_t RecordHandover::write(uint8_t *buffer) {
+	uint16_t offset = 0;
+	offset += mRecordHeader.write_header(buffer);
+	std::memcpy(buffer + offset,
+			mHandoverType == HANDOVER_SELECT ?
+					sSelectRecordType : sRequestRecordType,
+			sizeof(sSelectRecordType));
+	offset += sizeof(sSelectRecordType);
+	offset += write_id(buffer + offset);
+	buffer[offset++] = mVersion;
+
+	const uint32_t nRecords = (has_collision_resolution() ? 1 : 0)
+			+ mAlternativeCarriers.size() + (mErrorReason != 0 ? 1 : 0)
+			+ mOtherRecords.size();
+	uint32_t index = 0;
+
+	if (has_collision_resolution()) {
+		offset += write_nested_header(buffer + offset,
+				build_nested_header(sizeof(sCollisionRecordType),
+						COLLISION_RESOLUTION_LENGTH), sCollisionRecordType,
+				index == 0, index == nRecords - 1);
+		buffer[offset++] = (uint8_t) (mCollisionResolution >> 8);
+		buffer[offset++] = (uint8_t) (mCollisionResolution & 0xFF);
+		index++;
+	} //if
+
+	for (uint32_t i = 0; i < mAlternativeCarriers.size(); i++, index++) {
+		RecordAlternativeCarrier &carrier = mAlternativeCarriers[i];
+		carrier.set_as_middle_record();
+		if (index == 0)
+			carrier.set_as_first_record();
+		if (index == nRecords - 1)
+			carrier.set_as_last_record();
+		offset += carrier.write(buffer + offset);
+	} //for
+
+	if (mErrorReason != 0) {
+		offset += write_nested_header(buffer + offset,
+				build_nested_header(sizeof(sErrorRecordType),
+						1 + mErrorData.size()), sErrorRecordType, index == 0,
+				index == nRecords - 1);
+		buffer[offset++] = mErrorReason;
+		std::memcpy(buffer + offset, mErrorData.data(), mErrorData.size());
+		offset += mErrorData.size();
+		index++;
+	} //if
+
+	for (uint32_t i = 0; i < mOtherRecords.size(); i++, index++) {
+		UnknownRecord &other = *mOtherRecords[i];
+		other.set_as_middle_record();
+		if (index == 0)
+			other.set_as_first_record();
+		if (index == nRecords - 1)
+			other.set_as_last_record();
+		offset += other.write(buffer + offset);
+	} //for
+
+	return offset;
+}
+
+RecordHandover* RecordHandover::parse(const RecordHeader &header,
+		const uint8_t * const buffer) {
+	if ((header.get_FNT() != RecordHeader::NFC_well_known)
+			|| (header.get_type_length() != sizeof(sSelectRecordType))) {
+		return NULL;
+	} //else
+
+	HandoverType_t type;
+	if (std::memcmp(buffer, sSelectRecordType, sizeof(sSelectRecordType)) == 0)
+		type = HANDOVER_SELECT;
+	else if (std::memcmp(buffer, sRequestRecordType,
+			sizeof(sRequestRecordType)) == 0)
+		type = HANDOVER_REQUEST;
+	else
+		return NULL;
+
+	const uint8_t *payload = buffer + header.get_type_length()
+			+ header.get_id_length();
+	const uint32_t length = header.get_payload_length();
+	if (length == 0)
+		return NULL;
+
+	RecordHandover *r = new RecordHandover(type, payload[0]);
+	uint32_t offset = 1;
+
+	//parse the nested message, checking that each record is inside the payload
+	while (offset < length) {
+		RecordHeader nestedHeader;
+		const uint16_t headerLength = nestedHeader.load_header(payload + offset,
+				length - offset);
+		if (headerLength == 0) {
+			delete r;
+			return NULL;
+		} //if
+		const uint32_t typeAndIdLength = nestedHeader.get_type_length()
+				+ nestedHeader.get_id_length();
+
+		const uint8_t *nestedType = payload + offset + headerLength;
+		const uint8_t *nestedPayload = nestedType + typeAndIdLength;
+		const uint32_t nestedLength = nestedHeader.get_payload_length();
+
+		//the chunks are kept as they are
+		const bool isChunk = nestedHeader.get_CF()
+				|| nestedHeader.get_FNT() == RecordHeader::Unchanged;
+
+		RecordAlternativeCarrier *carrier = isChunk ? NULL :
+				RecordAlternativeCarrier::parse(nestedHeader, nestedType);
+		if (carrier != NULL) {
+			carrier->load_id(nestedHeader, nestedType);
+			r->mAlternativeCarriers.push_back(*carrier);
+			delete carrier;
+		} else if (!isChunk
+				&& nestedHeader.get_FNT() == RecordHeader::NFC_well_known
+				&& nestedHeader.get_type_length() == sizeof(sCollisionRecordType)
+				&& std::memcmp(nestedType, sCollisionRecordType,
+						sizeof(sCollisionRecordType)) == 0
+				&& nestedLength == COLLISION_RESOLUTION_LENGTH
+				&& r->has_collision_resolution()) {
+			r->mCollisionResolution = (((uint16_t) nestedPayload[0]) << 8)
+					| nestedPayload[1];
+		} else if (!isChunk
+				&& nestedHeader.get_FNT() == RecordHeader::NFC_well_known
+				&& nestedHeader.get_type_length() == sizeof(sErrorRecordType)
+				&& std::memcmp(nestedType, sErrorRecordType,
+						sizeof(sErrorRecordType)) == 0 && nestedLength >= 1
+				&& nestedPayload[0] != 0 && r->mErrorReason == 0) {
+			r->mErrorReason = nestedPayload[0];
+			r->mErrorData.assign((const char*) nestedPayload + 1,
+					nestedLength - 1);
+		} else {
+			//the other records are written back as they are read
+			r->mOtherRecords.push_back(
+					UnknownRecord::parse(nestedHeader, nestedType));
+		} //if-else
+
+		offset += headerLength + typeAndIdLength + nestedLength;
+	} //while
+
+	r->update_payload_length();
+	return r;
+}
+
+} /* namespace NDefLib */
@@ -0,0 +1,325 @@
+/**
+ ******************************************************************************
+ * @file    RecordHandover.h
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   Connection handover select and request records
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+#ifndef NDEFLIB_RECORDTYPE_RECORDHANDOVER_H_
+#define NDEFLIB_RECORDTYPE_RECORDHANDOVER_H_
+
+#include <string>
+#include <vector>
+
+#include "Record.h"
+#include "RecordAlternativeCarrier.h"
+#include "UnknownRecord.h"
+
+namespace NDefLib {
+
+/**
+ * Handover select ("Hs") or handover request ("Hr") record.
+ * @par The record payload is a nested message with the alternative carrier records,
+ * the carrier configuration records (for example {@link RecordBluetoothOob} or
+ * {@link RecordWifiConf}) must follow this record in the same message and their id
+ * must be the carrier data reference of the alternative carrier.
+ * @par Nested records other than alternative carrier, collision resolution and
+ * error records are kept as {@link UnknownRecord} and written back after the others,
+ * they are owned by this object.
+ * @see NFC Forum Connection Handover Technical Specification
+ */
+class RecordHandover: public Record {
+public:
+
+	/**
+	 * Kind of handover message
+	 */
+	typedef enum {
+		HANDOVER_SELECT, //!< Hs record, sent by the device that offers the carriers
+		HANDOVER_REQUEST //!< Hr record, sent by the device that asks for the carriers
+	} HandoverType_t;
+
+	/**
+	 * Handover version written by default: 1.3
+	 */
+	static const uint8_t DEFAULT_VERSION = 0x13;
+
+	/**
+	 * Create an RecordHandover reading the data from the buffer.
+ 	 * @param header Record header.
+	 * @param buffer Buffer to read the data from.
+	 * @return an object of type RecordHandover or NULL
+	 * @par User is in charge of freeing the pointer returned by this function.
+	 */
+	static RecordHandover* parse(const RecordHeader &header,
+			const uint8_t * const buffer);
+
+	/**
+	 * Build a new record without alternative carriers.
+	 * @param type Handover message type.
+	 * @param version Handover version, major version in the high nibble.
+	 */
+	explicit RecordHandover(HandoverType_t type=HANDOVER_SELECT,
+			uint8_t version=DEFAULT_VERSION);
+
+    /**
+     * Get the record type.
+     * @return TYPE_HANDOVER
+	 */
+	virtual RecordType_t get_type() const {
+		return TYPE_HANDOVER;
+	} //getType
+
+	/**
+	 * Get the handover message type.
+	 * @return HANDOVER_SELECT or HANDOVER_REQUEST
+	 */
+	HandoverType_t get_handover_type() const {
+		return mHandoverType;
+	}
+
+	/**
+	 * Get the handover version.
+	 * @return version, major version in the high nibble
+	 */
+	uint8_t get_version() const {
+		return mVersion;
+	}
+
+	/**
+	 * Change the handover version.
+	 * @param version new version, major version in the high nibble
+	 */
+	void set_version(uint8_t version){
+		mVersion=version;
+		update_payload_length();
+	}
+
+	/**
+	 * Get the random number used to resolve a handover request collision.
+	 * @return collision resolution number
+	 */
+	uint16_t get_collision_resolution() const {
+		return mCollisionResolution;
+	}
+
+	/**
+	 * Change the random number used to resolve a handover request collision.
+	 * @param randomNumber new number
+	 * @par The value is written only in a handover request with version 1.2 or later.
+	 */
+	void set_collision_resolution(uint16_t randomNumber){
+		mCollisionResolution=randomNumber;
+	}
+
+	/**
+	 * Get the number of alternative carriers.
+	 * @return number of alternative carriers
+	 */
+	uint32_t get_N_alternative_carriers() const {
+		return mAlternativeCarriers.size();
+	}
+
+	/**
+	 * Get an alternative carrier.
+	 * @param index carrier index, must be lower than get_N_alternative_carriers()
+	 * @return alternative carrier
+	 */
+	const RecordAlternativeCarrier& get_alternative_carrier(uint32_t index) const {
+		return mAlternativeCarriers[index];
+	}
+
+	/**
+	 * Add an alternative carrier, the carriers are written in order of preference.
+	 * @param carrier carrier to add, the record is copied
+	 */
+	void add_alternative_carrier(const RecordAlternativeCarrier &carrier){
+		mAlternativeCarriers.push_back(carrier);
+		update_payload_length();
+	}
+
+	/**
+	 * Remove all the alternative carriers.
+	 */
+	void remove_alternative_carriers(){
+		mAlternativeCarriers.clear();
+		update_payload_length();
+	}
+
+	/**
+	 * Get the error reason written in the handover select record.
+	 * @return error reason, 0 if the record doesn't contain an error
+	 */
+	uint8_t get_error_reason() const {
+		return mErrorReason;
+	}
+
+	/**
+	 * Get the data associated to the error.
+	 * @return error data
+	 */
+	const std::string& get_error_data() const {
+		return mErrorData;
+	}
+
+	/**
+	 * Change the error written in the handover select record.
+	 * @param reason error reason, 0 to remove the error
+	 * @param data error data
+	 */
+	void set_error(uint8_t reason,const std::string &data){
+		mErrorReason=reason;
+		mErrorData= reason!=0 ? data : std::string();
+		update_payload_length();
+	}
+
+	/**
+	 * Get the number of nested records that the handover doesn't handle.
+	 * @return number of other records
+	 */
+	uint32_t get_N_other_records() const {
+		return mOtherRecords.size();
+	}
+
+	/**
+	 * Get a nested record that the handover doesn't handle.
+	 * @param index record index, must be lower than get_N_other_records()
+	 * @return record as it was read
+	 */
+	const UnknownRecord& get_other_record(uint32_t index) const {
+		return *mOtherRecords[index];
+	}
+
+	virtual uint16_t write(uint8_t *buffer);
+	virtual ~RecordHandover();
+
+	/**
+	 * compare two objects
+	 * @return true if the records have the same type, version and nested records
+	 */
+	bool operator==(const RecordHandover &other) const{
+		return 	(mHandoverType==other.mHandoverType) &&
+				(mVersion==other.mVersion) &&
+				(!has_collision_resolution() ||
+						mCollisionResolution==other.mCollisionResolution) &&
+				(mAlternativeCarriers==other.mAlternativeCarriers) &&
+				(mErrorReason==other.mErrorReason) &&
+				(mErrorData==other.mErrorData) &&
+				same_other_records(other);
+	}
+
+private:
+
+	/**
+	 * The nested records are owned, copies are not allowed.
+	 */
+	RecordHandover(const RecordHandover&);
+	RecordHandover& operator=(const RecordHandover&);
+
+	/**
+	 * @return true if the records not handled by the class are the same
+	 */
+	bool same_other_records(const RecordHandover &other) const;
+
+	/**
+	 * Set the correct size of the payload, it is called every time the
+	 * content changes so write doesn't need to compute it again.
+	 */
+	void update_payload_length();
+
+	/**
+	 * @return true if the collision resolution record is written
+	 */
+	bool has_collision_resolution() const {
+		return mHandoverType==HANDOVER_REQUEST && mVersion>=0x12;
+	}
+
+	/**
+	 * Handover message type
+	 */
+	const HandoverType_t mHandoverType;
+
+	/**
+	 * Handover version
+	 */
+	uint8_t mVersion;
+
+	/**
+	 * Collision resolution random number
+	 */
+	uint16_t mCollisionResolution;
+
+	/**
+	 * Alternative carriers, in order of preference
+	 */
+	std::vector<RecordAlternativeCarrier> mAlternativeCarriers;
+
+	/**
+	 * Error reason, 0 if not present
+	 */
+	uint8_t mErrorReason;
+
+	/**
+	 * Error data
+	 */
+	std::string mErrorData;
+
+	/**
+	 * Nested records not handled by the class, in reading order
+	 */
+	std::vector<UnknownRecord*> mOtherRecords;
+
+	/**
+	 * Record type of the handover select record
+	 */
+	static const char sSelectRecordType[];
+
+	/**
+	 * Record type of the handover request record
+	 */
+	static const char sRequestRecordType[];
+
+	/**
+	 * Record type of the collision resolution record
+	 */
+	static const char sCollisionRecordType[];
+
+	/**
+	 * Record type of the error record
+	 */
+	static const char sErrorRecordType[];
+};
+
+} /* namespace NDefLib */
+
+#endif /* NDEFLIB_RECORDTYPE_RECORDHANDOVER_H_ */
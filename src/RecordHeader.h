@@ -66,7 +66,7 @@ public:
 
 
 	RecordHeader() :
-			headerFlags(0), typeLength(0), payloadLength(0) {
+			idLength(0), headerFlags(0), typeLength(0), payloadLength(0) {
 		set_SR(true);
 	}
 
@@ -228,8 +228,10 @@ public:
 		if(size!=0){
 			idLength = size;
 			set_IL(true);
-		}else
+		}else{
+			idLength = 0;
 			set_IL(false);
+		}//if-else
 
 	}
 
@@ -243,10 +245,10 @@ public:
 
 	/**
 	 * Get the number of bytes needed to store this record.
-	 * @return 3 or 6
+	 * @return header size (3 or 6, +1 if the id length is present) + type, id and payload size
 	 */
-	uint16_t get_record_length() const {
-		return (get_SR() ? 3 : 6) + (get_IL() ? idLength : 0)+typeLength + payloadLength;
+	uint32_t get_record_length() const {
+		return (get_SR() ? 3 : 6) + (get_IL() ? 1 + idLength : 0)+typeLength + payloadLength;
 	}
 
 	/**
@@ -301,6 +303,28 @@ public:
 		return index;
 	} //loadHeader
 
+	/**
+	 * Load an header from a buffer, checking that the whole record is inside the buffer.
+	 * @param buffer Buffer to load the header from.
+	 * @param bufferLength Number of bytes available in the buffer.
+	 * @return number of read bytes, 0 if the header or the record exceeds the buffer
+	 */
+	uint16_t load_header(const uint8_t * const buffer, const uint32_t bufferLength) {
+		if (bufferLength == 0)
+			return 0;
+		//flags + type length + payload length (1 or 4 bytes) + id length
+		const uint32_t headerLength = 2 + ((buffer[0] & 0x10) ? 1 : 4) +
+				((buffer[0] & 0x08) ? 1 : 0);
+		if (bufferLength < headerLength)
+			return 0;
+		load_header(buffer);
+		const uint32_t available = bufferLength - headerLength;
+		const uint32_t typeAndIdLength = (uint32_t) typeLength + idLength;
+		if (typeAndIdLength > available || payloadLength > available - typeAndIdLength)
+			return 0;
+		return headerLength;
+	} //loadHeader
+
 	/**
 	 * Equal operator.
 	 * @param other Other object to compare with.
@@ -0,0 +1,219 @@
+/**
+ ******************************************************************************
+ * @file    RecordList.h
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   List of records with inline storage for short messages
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+#ifndef NDEFLIB_RECORDLIST_H_
+#define NDEFLIB_RECORDLIST_H_
+
+#include <stdint.h>
+#include <cstring>
+
+#include "Record.h"
+
+/**
+ * Number of records stored inside the message object, longer messages
+ * move the list to the heap.
+ */
+#ifndef NDEF_MESSAGE_INLINE_RECORDS
+#define NDEF_MESSAGE_INLINE_RECORDS 4
+#endif
+
+namespace NDefLib {
+
+/**
+ * List of records used by {@link Message}, each entry remembers if the record
+ * is owned by the list.
+ * @par The first NDEF_MESSAGE_INLINE_RECORDS entries are stored inside the
+ * object, so a typical message doesn't use the heap.
+ */
+class RecordList {
+public:
+
+	/**
+	 * List entry.
+	 */
+	typedef struct {
+		Record *record; //!< record in the list
+		bool isOwned;   //!< true if the record must be deleted with the list
+	} Entry_t;
+
+	RecordList() :
+			mEntries(mInlineEntries), mSize(0), mCapacity(
+					NDEF_MESSAGE_INLINE_RECORDS) {
+	}
+
+	/**
+	 * Move the entries of another list inside this one, the other list is
+	 * left empty.
+	 * @param other List to move.
+	 */
+	RecordList(RecordList &&other) :
+			mEntries(mInlineEntries), mSize(0), mCapacity(
+					NDEF_MESSAGE_INLINE_RECORDS) {
+		take(other);
+	}
+
+	RecordList& operator=(RecordList &&other) {
+		if (this != &other) {
+			release_storage();
+			take(other);
+		}
+		return *this;
+	}
+
+	/**
+	 * @return number of entries in the list
+	 */
+	uint32_t size() const {
+		return mSize;
+	}
+
+	const Entry_t& operator[](const uint32_t index) const {
+		return mEntries[index];
+	}
+
+	/**
+	 * Add an entry at the end of the list.
+	 * @param r Record to add.
+	 * @param isOwned True if the record must be deleted with the list.
+	 * @return false if the list can not grow
+	 */
+	bool push_back(Record *r, const bool isOwned) {
+		if (mSize == mCapacity && !grow())
+			return false;
+		mEntries[mSize].record = r;
+		mEntries[mSize].isOwned = isOwned;
+		mSize++;
+		return true;
+	}
+
+	/**
+	 * Remove an entry, without deleting the record.
+	 * @param index Entry to remove.
+	 */
+	void erase(const uint32_t index) {
+		std::memmove(mEntries + index, mEntries + index + 1,
+				(mSize - index - 1) * sizeof(Entry_t));
+		mSize--;
+	}
+
+	/**
+	 * Remove all the entries, without deleting the records.
+	 */
+	void clear() {
+		mSize = 0;
+	}
+
+	~RecordList() {
+		release_storage();
+	}
+
+private:
+
+	/**
+	 * Double the list capacity, moving the entries to the heap.
+	 * @return false if the memory is not available
+	 */
+	bool grow() {
+		const uint32_t newCapacity = mCapacity * 2;
+		Entry_t *newEntries = new Entry_t[newCapacity];
+		if (newEntries == NULL)
+			return false;
+		std::memcpy(newEntries, mEntries, mSize * sizeof(Entry_t));
+		release_storage();
+		mEntries = newEntries;
+		mCapacity = newCapacity;
+		return true;
+	}
+
+	/**
+	 * Free the heap entries, if used.
+	 */
+	void release_storage() {
+		if (mEntries != mInlineEntries)
+			delete[] mEntries;
+		mEntries = mInlineEntries;
+		mCapacity = NDEF_MESSAGE_INLINE_RECORDS;
+	}
+
+	/**
+	 * Get the entries of another list, this list must be empty.
+	 * @param other List to empty.
+	 */
+	void take(RecordList &other) {
+		if (other.mEntries == other.mInlineEntries) {
+			std::memcpy(mInlineEntries, other.mInlineEntries,
+					other.mSize * sizeof(Entry_t));
+		} else {
+			mEntries = other.mEntries;
+			mCapacity = other.mCapacity;
+			other.mEntries = other.mInlineEntries;
+			other.mCapacity = NDEF_MESSAGE_INLINE_RECORDS;
+		} //if-else
+		mSize = other.mSize;
+		other.mSize = 0;
+	}
+
+	/**
+	 * The list can own its records, so it can be moved but not copied.
+	 */
+	RecordList(const RecordList&);
+	RecordList& operator=(const RecordList&);
+
+	/**
+	 * Entries stored inside the object.
+	 */
+	Entry_t mInlineEntries[NDEF_MESSAGE_INLINE_RECORDS];
+
+	/**
+	 * Entries in use: mInlineEntries or a heap buffer.
+	 */
+	Entry_t *mEntries;
+
+	/**
+	 * Number of entries in the list.
+	 */
+	uint32_t mSize;
+
+	/**
+	 * Number of entries available in mEntries.
+	 */
+	uint32_t mCapacity;
+};
+
+} /* namespace NDefLib */
+
+#endif /* NDEFLIB_RECORDLIST_H_ */
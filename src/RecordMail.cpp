@@ -60,10 +60,13 @@ RecordMail* RecordMail::parse(const RecordHeader &header,
         const uint8_t* buffer) {
     //not a uri tag or a mail tag
     if (buffer[0] != RecordURI::sNDEFUriIdCode
-            || buffer[1] != RecordURI::MAIL) {
+            || header.get_payload_length() == 0)
         return NULL;
-    }
-    const std::string uriContent((const char*) (buffer + 2),
+    //skip the record type and id
+    const uint8_t *payload = buffer + 1 + header.get_id_length();
+    if (payload[0] != RecordURI::MAIL)
+        return NULL;
+    const std::string uriContent((const char*) (payload + 1),
             header.get_payload_length() - 1);
 
     std::size_t subjectStart = uriContent.find(sSubjectTag);
@@ -38,6 +38,7 @@
 #include "RecordMimeType.h"
 #include "RecordVCard.h"
 #include "RecordWifiConf.h"
+#include "RecordBluetoothOob.h"
 
 namespace NDefLib {
 
@@ -73,7 +74,10 @@ uint16_t RecordMimeType::write(uint8_t *buffer) {
 	offset += mRecordHeader.write_header(buffer);
 	std::memcpy(buffer + offset, mMimeType.c_str(), mMimeType.size());
 	offset += mMimeType.size();
-	std::memcpy(buffer + offset, mData, mDataLength);
+	offset += write_id(buffer + offset);
+	//a parsed record with an empty payload has no data buffer
+	if (mData != NULL)
+		std::memcpy(buffer + offset, mData, mDataLength);
 	offset += mDataLength;
 	return offset;
 }
@@ -94,6 +98,10 @@ RecordMimeType* RecordMimeType::parse(const RecordHeader &header,
 	if (r != NULL)
 		return r;
 
+	r = RecordBluetoothOob::parse(header, buffer);
+	if (r != NULL)
+		return r;
+
 
 	//build a generic mameType
 	uint32_t dataOffset = offset + header.get_type_length()+header.get_id_length();
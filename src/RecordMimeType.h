@@ -146,11 +146,27 @@ public:
     /**
      * Compare two objects
      * @return true if the 2 records have the same mime type, length and data.
+     * @par Records without a data buffer (see {@link set_generated_data_length})
+     * are compared only by mime type and length, the subclasses compare
+     * their own fields.
      */
 	bool operator==(const RecordMimeType &other) const {
-		return 	mMimeType==other.mMimeType &&
-				mDataLength == other.mDataLength &&
-				(std::memcmp(mData,other.mData,mDataLength)==0);
+		if(mMimeType!=other.mMimeType || mDataLength != other.mDataLength)
+			return false;
+		if(mData==NULL || other.mData==NULL)
+			return mData==other.mData;
+		return std::memcmp(mData,other.mData,mDataLength)==0;
+	}
+
+protected:
+
+	/**
+	 * Set the content length for a subclass that generates the data
+	 * directly in the write buffer, so no data buffer is kept.
+	 * @param dataLength Number of bytes written by the subclass.
+	 */
+	void set_generated_data_length(uint32_t dataLength){
+		set_mime_data_pointer(NULL,dataLength);
 	}
 
 private:
@@ -65,18 +65,22 @@ void RecordSMS::update_content(){
 
 RecordSMS* RecordSMS::parse(const RecordHeader &header,
 		const uint8_t *buffer) {
-	uint16_t offset = 0;
-	if (buffer[offset++] != RecordURI::sNDEFUriIdCode)
+	if (buffer[0] != RecordURI::sNDEFUriIdCode)
+		return NULL;
+	if (header.get_payload_length() < 1 + sSmsTag.size())
 		return NULL;
-	if (buffer[offset++] != RecordURI::UNKNOWN)
+	//skip the record type and id
+	const uint8_t *payload = buffer + 1 + header.get_id_length();
+	uint16_t offset = 0;
+	if (payload[offset++] != RecordURI::UNKNOWN)
 		return NULL;
-	if (sSmsTag.compare(0, sSmsTag.size(), (const char*) buffer + offset,
+	if (sSmsTag.compare(0, sSmsTag.size(), (const char*) payload + offset,
 			sSmsTag.size()) != 0)
 		return NULL;
 	offset += sSmsTag.size();
 
-	const std::string uriContent((const char*) (buffer + offset),
-			header.get_payload_length() - offset+1);
+	const std::string uriContent((const char*) (payload + offset),
+			header.get_payload_length() - offset);
 
 	std::size_t numberEnd = uriContent.find(sBodyTag);
 	if (numberEnd == std::string::npos)
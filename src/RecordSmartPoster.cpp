@@ -0,0 +1,346 @@
+/**
+ ******************************************************************************
+ * @file    RecordSmartPoster.cpp
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   RecordSmartPoster implementation.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+#include <cstring>
+#include "RecordSmartPoster.h"
+
+namespace NDefLib {
+
+const char RecordSmartPoster::sRecordType[] = { 'S', 'p' };
+const char RecordSmartPoster::sActionRecordType[] = { 'a', 'c', 't' };
+const char RecordSmartPoster::sSizeRecordType[] = { 's' };
+const char RecordSmartPoster::sTypeRecordType[] = { 't' };
+
+//size of the payload of the size record
+#define SIZE_RECORD_LENGTH 4
+
+RecordSmartPoster::RecordSmartPoster(const std::string &uri) :
+		mUri(new RecordURI(RecordURI::UNKNOWN, uri)), mAction(ACTION_NOT_SET),
+		mSize(0), mHasSize(false), mIcon(NULL) {
+	mRecordHeader.set_FNT(RecordHeader::NFC_well_known);
+	mRecordHeader.set_type_length(sizeof(sRecordType));
+	update_payload_length();
+}
+
+RecordSmartPoster::~RecordSmartPoster() {
+	delete mUri;
+	delete mIcon;
+	for (uint32_t i = 0; i < mOtherRecords.size(); i++)
+		delete mOtherRecords[i];
+}
+
+void RecordSmartPoster::set_uri(const std::string &uri) {
+	delete mUri;
+	mUri = new RecordURI(RecordURI::UNKNOWN, uri);
+}
+
+const RecordText* RecordSmartPoster::get_title(
+		const std::string &language) const {
+	const RecordText *bestTitle = NULL;
+	for (uint32_t i = 0; i < mTitles.size(); i++) {
+		const RecordText::LanguageMatch_t match =
+				mTitles[i].match_language(language);
+		if (match == RecordText::LANGUAGE_EXACT_MATCH)
+			return &mTitles[i];
+		if (match == RecordText::LANGUAGE_PRIMARY_MATCH && bestTitle == NULL)
+			bestTitle = &mTitles[i];
+	} //for
+	return bestTitle;
+}
+
+void RecordSmartPoster::set_icon(const std::string &mimeType,
+		const uint8_t *data, uint32_t length) {
+	delete mIcon;
+	mIcon = new RecordMimeType(mimeType, data, length);
+}
+
+void RecordSmartPoster::remove_icon() {
+	delete mIcon;
+	mIcon = NULL;
+}
+
+/**
+ * Build the header of a record inside the nested message.
+ * @param typeLength Record type length.
+ * @param payloadLength Record payload length.
+ * @return record header
+ */
+static RecordHeader build_nested_header(const uint8_t typeLength,
+		const uint32_t payloadLength) {
+	RecordHeader header;
+	header.set_FNT(RecordHeader::NFC_well_known);
+	header.set_type_length(typeLength);
+	header.set_payload_length(payloadLength);
+	return header;
+}
+
+void RecordSmartPoster::update_payload_length() {
+	uint32_t length = mUri->get_byte_length();
+	for (uint32_t i = 0; i < mTitles.size(); i++)
+		length += mTitles[i].get_byte_length();
+	if (mAction != ACTION_NOT_SET)
+		length += build_nested_header(sizeof(sActionRecordType), 1).get_record_length();
+	if (mHasSize)
+		length += build_nested_header(sizeof(sSizeRecordType),
+				SIZE_RECORD_LENGTH).get_record_length();
+	if (!mContentType.empty())
+		length += build_nested_header(sizeof(sTypeRecordType),
+				mContentType.size()).get_record_length();
+	if (mIcon != NULL)
+		length += mIcon->get_byte_length();
+	for (uint32_t i = 0; i < mOtherRecords.size(); i++)
+		length += mOtherRecords[i]->get_byte_length();
+	mRecordHeader.set_payload_length(length);
+}
+
+/**
+ * Set the message begin/end flags of a record inside the nested message.
+ * @param record Nested record.
+ * @param index Record position.
+ * @param nRecords Number of records in the nested message.
+ */
+static void set_nested_position(Record &record, const uint32_t index,
+		const uint32_t nRecords) {
+	record.set_as_middle_record();
+	if (index == 0)
+		record.set_as_first_record();
+	if (index == nRecords - 1)
+		record.set_as_last_record();
+}
+
+/**
+ * Write the header and the type of a record inside the nested message.
+ * @return number of bytes written
+ */
+static uint16_t write_nested_header(uint8_t *buffer, RecordHeader header,
+		const char *type, const uint32_t index, const uint32_t nRecords) {
+	header.set_MB(index == 0);
+	header.set_ME(index == nRecords - 1);
+	uint16_t offset = header.write_header(buffer);
+	std::memcpy(buffer + offset, type, header.get_type_length());
+	return offset + header.get_type_length();
+}
+
+uint16_t RecordSmartPoster::write(uint8_t *buffer) {
+	update_payload_length();
+
+	uint16_t offset = 0;
+	offset += mRecordHeader.write_header(buffer);
+	std::memcpy(buffer + offset, sRecordType, sizeof(sRecordType));
+	offset += sizeof(sRecordType);
+	offset += write_id(buffer + offset);
+
+	const uint32_t nRecords = 1 + mTitles.size()
+			+ (mAction != ACTION_NOT_SET ? 1 : 0) + (mHasSize ? 1 : 0)
+			+ (!mContentType.empty() ? 1 : 0) + (mIcon != NULL ? 1 : 0)
+			+ mOtherRecords.size();
+	uint32_t index = 0;
+
+	set_nested_position(*mUri, index++, nRecords);
+	offset += mUri->write(buffer + offset);
+
+	for (uint32_t i = 0; i < mTitles.size(); i++) {
+		set_nested_position(mTitles[i], index++, nRecords);
+		offset += mTitles[i].write(buffer + offset);
+	} //for
+
+	if (mAction != ACTION_NOT_SET) {
+		offset += write_nested_header(buffer + offset,
+				build_nested_header(sizeof(sActionRecordType), 1),
+				sActionRecordType, index++, nRecords);
+		buffer[offset++] = (uint8_t) mAction;
+	} //if
+
+	if (mHasSize) {
+		offset += write_nested_header(buffer + offset,
+				build_nested_header(sizeof(sSizeRecordType), SIZE_RECORD_LENGTH),
+				sSizeRecordType, index++, nRecords);
+		buffer[offset++] = (uint8_t) (mSize >> 24);
+		buffer[offset++] = (uint8_t) (mSize >> 16);
+		buffer[offset++] = (uint8_t) (mSize >> 8);
+		buffer[offset++] = (uint8_t) mSize;
+	} //if
+
+	if (!mContentType.empty()) {
+		offset += write_nested_header(buffer + offset,
+				build_nested_header(sizeof(sTypeRecordType),
+						mContentType.size()), sTypeRecordType, index++,
+				nRecords);
+		std::memcpy(buffer + offset, mContentType.data(), mContentType.size());
+		offset += mContentType.size();
+	} //if
+
+	if (mIcon != NULL) {
+		set_nested_position(*mIcon, index++, nRecords);
+		offset += mIcon->write(buffer + offset);
+	} //if
+
+	for (uint32_t i = 0; i < mOtherRecords.size(); i++) {
+		set_nested_position(*mOtherRecords[i], index++, nRecords);
+		offset += mOtherRecords[i]->write(buffer + offset);
+	} //for
+
+	return offset;
+}
+
+/**
+ * Check the type of a well known record.
+ * @return true if the record has the well known type
+ */
+static bool is_well_known_type(const RecordHeader &header,
+		const uint8_t *type, const char *knownType,
+		const uint8_t knownTypeLength) {
+	return header.get_FNT() == RecordHeader::NFC_well_known
+			&& header.get_type_length() == knownTypeLength
+			&& std::memcmp(type, knownType, knownTypeLength) == 0;
+}
+
+/**
+ * Check if a mime record can be used as icon.
+ * @return true for an image or a video
+ */
+static bool is_icon(const RecordMimeType &record) {
+	const std::string &type = record.get_mime_type();
+	return type.compare(0, 6, "image/") == 0
+			|| type.compare(0, 6, "video/") == 0;
+}
+
+RecordSmartPoster* RecordSmartPoster::parse(const RecordHeader &header,
+		const uint8_t * const buffer) {
+	if (!is_well_known_type(header, buffer, sRecordType, sizeof(sRecordType)))
+		return NULL;
+
+	const uint8_t *payload = buffer + header.get_type_length()
+			+ header.get_id_length();
+	const uint32_t length = header.get_payload_length();
+
+	RecordSmartPoster *r = new RecordSmartPoster(std::string());
+	bool hasUri = false;
+
+	//parse the nested message, checking that each record is inside the payload
+	uint32_t offset = 0;
+	while (offset < length) {
+		RecordHeader nestedHeader;
+		const uint16_t headerLength = nestedHeader.load_header(payload + offset,
+				length - offset);
+		if (headerLength == 0) {
+			delete r;
+			return NULL;
+		} //if
+
+		const uint8_t *nestedType = payload + offset + headerLength;
+		const uint8_t *nestedPayload = nestedType
+				+ nestedHeader.get_type_length() + nestedHeader.get_id_length();
+		const uint32_t nestedLength = nestedHeader.get_payload_length();
+
+		bool handled = false;
+		if (nestedHeader.get_CF()
+				|| nestedHeader.get_FNT() == RecordHeader::Unchanged) {
+			//the chunks are kept as they are
+		} else if (is_well_known_type(nestedHeader, nestedType, "U", 1)
+				&& !hasUri && nestedLength >= 1) {
+			RecordURI *uri = RecordURI::parse(nestedHeader, nestedType);
+			if (uri != NULL) {
+				uri->load_id(nestedHeader, nestedType);
+				delete r->mUri;
+				r->mUri = uri;
+				hasUri = true;
+				handled = true;
+			} //if
+		} else if (is_well_known_type(nestedHeader, nestedType, "T", 1)
+				&& nestedLength >= 1
+				&& (nestedPayload[0] & 0x3Fu) < nestedLength) {
+			//the title must contain the status byte and the language code
+			RecordText *title = RecordText::parse(nestedHeader, nestedType);
+			if (title != NULL) {
+				title->load_id(nestedHeader, nestedType);
+				r->mTitles.push_back(*title);
+				delete title;
+				handled = true;
+			} //if
+		} else if (is_well_known_type(nestedHeader, nestedType,
+				sActionRecordType, sizeof(sActionRecordType))
+				&& nestedLength == 1 && r->mAction == ACTION_NOT_SET
+				&& nestedPayload[0] != ACTION_NOT_SET) {
+			r->mAction = (Action_t) nestedPayload[0];
+			handled = true;
+		} else if (is_well_known_type(nestedHeader, nestedType,
+				sSizeRecordType, sizeof(sSizeRecordType))
+				&& nestedLength == SIZE_RECORD_LENGTH && !r->mHasSize) {
+			r->set_size(
+					(((uint32_t) nestedPayload[0]) << 24)
+							| (((uint32_t) nestedPayload[1]) << 16)
+							| (((uint32_t) nestedPayload[2]) << 8)
+							| nestedPayload[3]);
+			handled = true;
+		} else if (is_well_known_type(nestedHeader, nestedType,
+				sTypeRecordType, sizeof(sTypeRecordType))
+				&& nestedLength > 0 && r->mContentType.empty()) {
+			r->mContentType.assign((const char*) nestedPayload, nestedLength);
+			handled = true;
+		} else if (nestedHeader.get_FNT() == RecordHeader::Mime_media_type
+				&& r->mIcon == NULL) {
+			RecordMimeType *icon = RecordMimeType::parse(nestedHeader,
+					nestedType);
+			if (icon != NULL && is_icon(*icon)) {
+				icon->load_id(nestedHeader, nestedType);
+				r->mIcon = icon;
+				handled = true;
+			} else
+				delete icon;
+		} //if-else
+
+		//the other records are written back as they are read
+		if (!handled) {
+			UnknownRecord *other = UnknownRecord::parse(nestedHeader,
+					nestedType);
+			r->mOtherRecords.push_back(other);
+		} //if
+
+		offset += headerLength + nestedHeader.get_type_length()
+				+ nestedHeader.get_id_length() + nestedLength;
+	} //while
+
+	if (!hasUri) {
+		delete r;
+		return NULL;
+	} //if
+
+	r->update_payload_length();
+	return r;
+}
+
+} /* namespace NDefLib */
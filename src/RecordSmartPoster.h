@@ -0,0 +1,344 @@
+/**
+ ******************************************************************************
+ * @file    RecordSmartPoster.h
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   Smart poster record: an URI with titles and actions
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+#ifndef NDEFLIB_RECORDTYPE_RECORDSMARTPOSTER_H_
+#define NDEFLIB_RECORDTYPE_RECORDSMARTPOSTER_H_
+
+#include <string>
+#include <vector>
+
+#include "Record.h"
+#include "RecordURI.h"
+#include "RecordText.h"
+#include "RecordMimeType.h"
+#include "UnknownRecord.h"
+
+namespace NDefLib {
+
+/**
+ * Smart poster record ("Sp"), its payload is a nested message with an URI record,
+ * the titles in different languages, the recommended action, the size and type of
+ * the referenced content and an icon.
+ * @par The nested records are owned by this object.
+ * @par Nested records that are not handled (other types, chunks, a second URI or
+ * a mime record that is not an icon) are kept as {@link UnknownRecord} and written
+ * back after the others.
+ * @see NFC Forum Smart Poster Record Type Definition
+ */
+class RecordSmartPoster: public Record {
+public:
+
+	/**
+	 * Recommended action for the URI
+	 */
+	typedef enum {
+		ACTION_DO = 0x00,     //!< open the URI
+		ACTION_SAVE = 0x01,   //!< save the URI for later
+		ACTION_OPEN = 0x02,   //!< open the URI for editing
+		ACTION_NOT_SET = 0xFF //!< the action record is not written
+	} Action_t;
+
+	/**
+	 * Create an RecordSmartPoster reading the data from the buffer.
+ 	 * @param header Record header.
+	 * @param buffer Buffer to read the data from.
+	 * @return an object of type RecordSmartPoster or NULL if the nested message
+	 * is malformed or doesn't contain an URI
+	 * @par User is in charge of freeing the pointer returned by this function.
+	 */
+	static RecordSmartPoster* parse(const RecordHeader &header,
+			const uint8_t * const buffer);
+
+	/**
+	 * Build a new smart poster.
+	 * @param uri URI of the poster, the known prefix is abbreviated.
+	 */
+	explicit RecordSmartPoster(const std::string &uri);
+
+    /**
+     * Get the record type.
+     * @return TYPE_SMART_POSTER
+	 */
+	virtual RecordType_t get_type() const {
+		return TYPE_SMART_POSTER;
+	} //getType
+
+	/**
+	 * Get the URI record.
+	 * @return URI record, it can be a subclass as {@link RecordMail} for a parsed record
+	 */
+	RecordURI& get_uri() {
+		return *mUri;
+	}
+
+	/**
+	 * Change the poster URI.
+	 * @param uri new URI, the known prefix is abbreviated.
+	 */
+	void set_uri(const std::string &uri);
+
+	/**
+	 * Get the number of titles.
+	 * @return number of titles
+	 */
+	uint32_t get_N_titles() const {
+		return mTitles.size();
+	}
+
+	/**
+	 * Get a title.
+	 * @param index title index, must be lower than get_N_titles()
+	 * @return title record
+	 */
+	const RecordText& get_title(uint32_t index) const {
+		return mTitles[index];
+	}
+
+	/**
+	 * Search the title in a language.
+	 * @par If there isn't a title with the same language code, the first title
+	 * with the same primary language is returned ("en-US" for "en").
+	 * @param language language code
+	 * @return title record, NULL if there is not a title in that language
+	 */
+	const RecordText* get_title(const std::string &language) const;
+
+	/**
+	 * Add a title, there should be only one title per language.
+	 * @param title title text
+	 * @param language title language code
+	 */
+	void add_title(const std::string &title,const std::string &language="en"){
+		mTitles.push_back(RecordText(RecordText::UTF8,language,title));
+	}
+
+	/**
+	 * Remove all the titles.
+	 */
+	void remove_titles(){
+		mTitles.clear();
+	}
+
+	/**
+	 * Get the recommended action.
+	 * @return action, ACTION_NOT_SET if the poster doesn't have it
+	 */
+	Action_t get_action() const {
+		return mAction;
+	}
+
+	/**
+	 * Change the recommended action.
+	 * @param action new action, ACTION_NOT_SET to remove it
+	 */
+	void set_action(Action_t action){
+		mAction=action;
+	}
+
+	/**
+	 * Tell if the poster contains the size of the referenced content.
+	 * @return true if the size is present
+	 */
+	bool has_size() const {
+		return mHasSize;
+	}
+
+	/**
+	 * Get the size of the referenced content.
+	 * @return size in bytes, 0 if not present
+	 */
+	uint32_t get_size() const {
+		return mSize;
+	}
+
+	/**
+	 * Change the size of the referenced content.
+	 * @param size size in bytes
+	 */
+	void set_size(uint32_t size){
+		mSize=size;
+		mHasSize=true;
+	}
+
+	/**
+	 * Remove the size of the referenced content.
+	 */
+	void remove_size(){
+		mSize=0;
+		mHasSize=false;
+	}
+
+	/**
+	 * Get the mime type of the referenced content.
+	 * @return mime type, an empty string if not present
+	 */
+	const std::string& get_content_type() const {
+		return mContentType;
+	}
+
+	/**
+	 * Change the mime type of the referenced content.
+	 * @param type mime type, an empty string to remove it
+	 */
+	void set_content_type(const std::string &type){
+		mContentType=type;
+	}
+
+	/**
+	 * Get the icon.
+	 * @return icon record or NULL if the poster doesn't have an icon
+	 */
+	const RecordMimeType* get_icon() const {
+		return mIcon;
+	}
+
+	/**
+	 * Change the icon.
+	 * @param mimeType image or video mime type.
+	 * @param data icon content, it is copied inside the record.
+	 * @param length number of bytes of the icon.
+	 */
+	void set_icon(const std::string &mimeType,const uint8_t *data,uint32_t length);
+
+	/**
+	 * Remove the icon.
+	 */
+	void remove_icon();
+
+	/**
+	 * Get the number of nested records that the poster doesn't handle.
+	 * @return number of other records
+	 */
+	uint32_t get_N_other_records() const {
+		return mOtherRecords.size();
+	}
+
+	/**
+	 * Get a nested record that the poster doesn't handle.
+	 * @param index record index, must be lower than get_N_other_records()
+	 * @return record as it was read
+	 */
+	const UnknownRecord& get_other_record(uint32_t index) const {
+		return *mOtherRecords[index];
+	}
+
+	virtual uint32_t get_byte_length() {
+		update_payload_length();
+		return mRecordHeader.get_record_length();
+	}
+
+	virtual uint16_t write(uint8_t *buffer);
+
+	virtual ~RecordSmartPoster();
+
+private:
+
+	/**
+	 * The nested records are owned, copies are not allowed.
+	 */
+	RecordSmartPoster(const RecordSmartPoster&);
+	RecordSmartPoster& operator=(const RecordSmartPoster&);
+
+	/**
+	 * Set the correct size of the payload.
+	 */
+	void update_payload_length();
+
+	/**
+	 * URI record
+	 */
+	RecordURI *mUri;
+
+	/**
+	 * Title records
+	 */
+	std::vector<RecordText> mTitles;
+
+	/**
+	 * Recommended action
+	 */
+	Action_t mAction;
+
+	/**
+	 * Size of the referenced content
+	 */
+	uint32_t mSize;
+
+	/**
+	 * True if the size is written
+	 */
+	bool mHasSize;
+
+	/**
+	 * Mime type of the referenced content
+	 */
+	std::string mContentType;
+
+	/**
+	 * Icon record, NULL if not present
+	 */
+	RecordMimeType *mIcon;
+
+	/**
+	 * Nested records not handled by the poster, in reading order
+	 */
+	std::vector<UnknownRecord*> mOtherRecords;
+
+	/**
+	 * Record type of the smart poster record
+	 */
+	static const char sRecordType[];
+
+	/**
+	 * Record type of the action record
+	 */
+	static const char sActionRecordType[];
+
+	/**
+	 * Record type of the size record
+	 */
+	static const char sSizeRecordType[];
+
+	/**
+	 * Record type of the content type record
+	 */
+	static const char sTypeRecordType[];
+};
+
+} /* namespace NDefLib */
+
+#endif /* NDEFLIB_RECORDTYPE_RECORDSMARTPOSTER_H_ */
@@ -35,6 +35,7 @@
  ******************************************************************************
  */
 
+#include <cctype>
 #include <cstring>
 #include <RecordText.h>
 
@@ -42,6 +43,134 @@ namespace NDefLib {
 
 const uint8_t RecordText::NDEFTextIdCode = 'T';
 
+/**
+ * Character used in place of a not valid UTF8/UTF16 sequence.
+ */
+static const uint32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+/**
+ * Check 4 UTF8 bytes with a single operation.
+ * @param text Text to check, at least 4 bytes long.
+ * @return true if the 4 bytes are ASCII characters
+ */
+static bool is_ascii_utf8(const uint8_t *text) {
+	uint32_t word;
+	std::memcpy(&word, text, sizeof(word));
+	return (word & 0x80808080) == 0;
+}
+
+/**
+ * Check 4 UTF16 units, without a branch for each unit.
+ * @param text Text to check, at least 8 bytes long.
+ * @param high Offset of the most significant byte of each unit.
+ * @return true if the 4 units are ASCII characters
+ */
+static bool is_ascii_utf16(const uint8_t *text, const uint8_t high) {
+	const uint8_t low = 1 - high;
+	return (text[high] | text[high + 2] | text[high + 4] | text[high + 6]) == 0
+			&& ((text[low] | text[low + 2] | text[low + 4] | text[low + 6])
+					& 0x80) == 0;
+}
+
+/**
+ * Decode a character from a UTF8 text.
+ * @param text Text to read, at least 1 byte long.
+ * @param length Number of bytes in the text.
+ * @param[out] codePoint Decoded character, REPLACEMENT_CHARACTER if not valid.
+ * @return number of bytes read
+ */
+static uint8_t decode_utf8(const uint8_t *text, const uint32_t length,
+		uint32_t *codePoint) {
+	const uint8_t first = text[0];
+	uint8_t nBytes;
+	uint32_t minValue;
+	uint32_t value;
+
+	*codePoint = REPLACEMENT_CHARACTER;
+	if (first < 0x80) {
+		*codePoint = first;
+		return 1;
+	} else if ((first & 0xE0) == 0xC0) {
+		nBytes = 2;
+		minValue = 0x80;
+		value = first & 0x1F;
+	} else if ((first & 0xF0) == 0xE0) {
+		nBytes = 3;
+		minValue = 0x800;
+		value = first & 0x0F;
+	} else if ((first & 0xF8) == 0xF0) {
+		nBytes = 4;
+		minValue = 0x10000;
+		value = first & 0x07;
+	} else
+		return 1;
+
+	if (nBytes > length)
+		return 1;
+	for (uint8_t i = 1; i < nBytes; i++) {
+		if ((text[i] & 0xC0) != 0x80)
+			return i;
+		value = (value << 6) | (text[i] & 0x3F);
+	} //for
+
+	//overlong encodings, surrogates and values out of the unicode range
+	if (value >= minValue && value <= 0x10FFFF
+			&& (value < 0xD800 || value > 0xDFFF))
+		*codePoint = value;
+	return nBytes;
+}
+
+/**
+ * Encode a character as UTF8.
+ * @param codePoint Character to encode.
+ * @param[out] buffer Buffer where write the character, at least 4 bytes long.
+ * @return number of bytes written
+ */
+static uint8_t encode_utf8(const uint32_t codePoint, uint8_t *buffer) {
+	if (codePoint < 0x80) {
+		buffer[0] = (uint8_t) codePoint;
+		return 1;
+	} else if (codePoint < 0x800) {
+		buffer[0] = (uint8_t) (0xC0 | (codePoint >> 6));
+		buffer[1] = (uint8_t) (0x80 | (codePoint & 0x3F));
+		return 2;
+	} else if (codePoint < 0x10000) {
+		buffer[0] = (uint8_t) (0xE0 | (codePoint >> 12));
+		buffer[1] = (uint8_t) (0x80 | ((codePoint >> 6) & 0x3F));
+		buffer[2] = (uint8_t) (0x80 | (codePoint & 0x3F));
+		return 3;
+	} //else
+	buffer[0] = (uint8_t) (0xF0 | (codePoint >> 18));
+	buffer[1] = (uint8_t) (0x80 | ((codePoint >> 12) & 0x3F));
+	buffer[2] = (uint8_t) (0x80 | ((codePoint >> 6) & 0x3F));
+	buffer[3] = (uint8_t) (0x80 | (codePoint & 0x3F));
+	return 4;
+}
+
+/**
+ * Read a UTF16 unit.
+ * @param text Text to read, at least 2 bytes long.
+ * @param high Offset of the most significant byte.
+ * @return UTF16 unit
+ */
+static uint16_t read_utf16(const uint8_t *text, const uint8_t high) {
+	return (uint16_t) ((text[high] << 8) | text[1 - high]);
+}
+
+/**
+ * Compare the first bytes of 2 strings, ignoring the case.
+ * @return true if the first length bytes are equal
+ */
+static bool equal_ignore_case(const std::string &a, const std::string &b,
+		const std::string::size_type length) {
+	for (std::string::size_type i = 0; i < length; i++) {
+		if (std::tolower((unsigned char) a[i])
+				!= std::tolower((unsigned char) b[i]))
+			return false;
+	} //for
+	return true;
+}
+
 void RecordText::set_record_header() {
 	mRecordHeader.set_FNT(RecordHeader::NFC_well_known);
 	mRecordHeader.set_type_length(sizeof(NDEFTextIdCode));
@@ -66,6 +195,7 @@ uint16_t RecordText::write(uint8_t *buffer) {
 	offset += mRecordHeader.write_header(buffer);
 
 	buffer[offset++] = NDEFTextIdCode;
+	offset += write_id(buffer + offset);
 	buffer[offset++] = mTextStatus;
 
 	std::memcpy(buffer + offset, mLanguage.c_str(), mLanguage.size());
@@ -75,17 +205,145 @@ uint16_t RecordText::write(uint8_t *buffer) {
 	return offset;
 }
 
+RecordText::LanguageMatch_t RecordText::match_language(
+		const std::string &language) const {
+	if (mLanguage.size() == language.size()
+			&& equal_ignore_case(mLanguage, language, language.size()))
+		return LANGUAGE_EXACT_MATCH;
+
+	//the primary language is the code before the first '-'
+	const std::string::size_type primaryLength = mLanguage.find('-');
+	const std::string::size_type otherPrimaryLength = language.find('-');
+	const std::string::size_type length =
+			primaryLength == std::string::npos ? mLanguage.size() : primaryLength;
+	const std::string::size_type otherLength =
+			otherPrimaryLength == std::string::npos ?
+					language.size() : otherPrimaryLength;
+
+	if (length != 0 && length == otherLength
+			&& equal_ignore_case(mLanguage, language, length))
+		return LANGUAGE_PRIMARY_MATCH;
+	return LANGUAGE_NO_MATCH;
+}
+
+std::string RecordText::utf8_to_utf16(const std::string &text) {
+	const uint8_t *in = (const uint8_t*) text.data();
+	const uint32_t length = text.size();
+
+	//each UTF8 byte becomes at most 2 UTF16 bytes
+	std::string utf16(length * 2, '\0');
+	uint8_t *out = (uint8_t*) &utf16[0];
+	uint32_t offset = 0;
+	uint32_t i = 0;
+
+	while (i < length) {
+		//fast path: 4 ascii characters at a time
+		if (i + 4 <= length && is_ascii_utf8(in + i)) {
+			out[offset] = 0;
+			out[offset + 1] = in[i];
+			out[offset + 2] = 0;
+			out[offset + 3] = in[i + 1];
+			out[offset + 4] = 0;
+			out[offset + 5] = in[i + 2];
+			out[offset + 6] = 0;
+			out[offset + 7] = in[i + 3];
+			offset += 8;
+			i += 4;
+			continue;
+		} //if
+
+		uint32_t codePoint;
+		i += decode_utf8(in + i, length - i, &codePoint);
+		if (codePoint >= 0x10000) {
+			//surrogate pair
+			codePoint -= 0x10000;
+			const uint16_t high = 0xD800 | (codePoint >> 10);
+			const uint16_t low = 0xDC00 | (codePoint & 0x3FF);
+			out[offset++] = (uint8_t) (high >> 8);
+			out[offset++] = (uint8_t) (high & 0xFF);
+			out[offset++] = (uint8_t) (low >> 8);
+			out[offset++] = (uint8_t) (low & 0xFF);
+		} else {
+			out[offset++] = (uint8_t) (codePoint >> 8);
+			out[offset++] = (uint8_t) (codePoint & 0xFF);
+		} //if-else
+	} //while
+
+	utf16.resize(offset);
+	return utf16;
+}
+
+std::string RecordText::utf16_to_utf8(const uint8_t *text, uint32_t length) {
+	uint8_t high = 0; //big endian
+	uint32_t i = 0;
+	if (length >= 2) {
+		if (text[0] == 0xFE && text[1] == 0xFF)
+			i = 2;
+		else if (text[0] == 0xFF && text[1] == 0xFE) {
+			high = 1;
+			i = 2;
+		} //if-else
+	} //if
+
+	//each UTF16 unit becomes at most 3 UTF8 bytes, +3 for a truncated unit
+	std::string utf8((length / 2) * 3 + 3, '\0');
+	uint8_t *out = (uint8_t*) &utf8[0];
+	uint32_t offset = 0;
+
+	while (i + 1 < length) {
+		//fast path: 4 ascii characters at a time
+		if (i + 8 <= length && is_ascii_utf16(text + i, high)) {
+			out[offset] = text[i + 1 - high];
+			out[offset + 1] = text[i + 3 - high];
+			out[offset + 2] = text[i + 5 - high];
+			out[offset + 3] = text[i + 7 - high];
+			offset += 4;
+			i += 8;
+			continue;
+		} //if
+
+		uint32_t codePoint = read_utf16(text + i, high);
+		i += 2;
+		if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+			const uint16_t low = i + 1 < length ? read_utf16(text + i, high) : 0;
+			if (low >= 0xDC00 && low <= 0xDFFF) {
+				codePoint = 0x10000 + ((codePoint - 0xD800) << 10)
+						+ (low - 0xDC00);
+				i += 2;
+			} else
+				codePoint = REPLACEMENT_CHARACTER;
+		} else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF)
+			codePoint = REPLACEMENT_CHARACTER;
+
+		offset += encode_utf8(codePoint, out + offset);
+	} //while
+
+	//odd number of bytes
+	if (i < length)
+		offset += encode_utf8(REPLACEMENT_CHARACTER, out + offset);
+
+	utf8.resize(offset);
+	return utf8;
+}
+
 RecordText* RecordText::parse(const RecordHeader &header,
 		const uint8_t * const buffer) {
 	uint32_t index = 0;
 	if (header.get_FNT() == RecordHeader::NFC_well_known
+			&& header.get_type_length() == 1
 			&& buffer[index++] == NDEFTextIdCode) {
+		index += header.get_id_length();
 
+		const uint32_t payloadLength = header.get_payload_length();
+		if (payloadLength == 0)
+			return NULL;
 		const uint8_t textStatus = buffer[index++];
 		const TextEncoding enc = get_encoding(textStatus);
 		const uint8_t langSize = get_language_length(textStatus);
 		//-1 is the textStatus
-		const uint8_t textSize = header.get_payload_length() - langSize - 1;
+		if (langSize > payloadLength - 1)
+			return NULL;
+		const uint32_t textSize = payloadLength - langSize - 1;
 
 		return new RecordText(enc,
 				std::string((const char*) (buffer + index), langSize),
@@ -68,6 +68,15 @@ public:
 		UTF16,//!< UTF16
 	} TextEncoding;
 
+	/**
+	 * How much a record language is similar to a requested language.
+	 */
+	typedef enum {
+		LANGUAGE_NO_MATCH,      //!< different languages
+		LANGUAGE_PRIMARY_MATCH, //!< same primary language, as "en" and "en-US"
+		LANGUAGE_EXACT_MATCH    //!< same language code
+	} LanguageMatch_t;
+
 	/**
 	 * Build a utf8, English text record.
 	 * @param text Text to store in the record.
@@ -108,6 +117,24 @@ public:
 		update_playload_length();
 	}
 
+	/**
+	 * Get the text inside this record, converted to UTF8 if the record uses UTF16.
+	 * @return the text content as UTF8
+	 */
+	std::string get_text_utf8() const {
+		if (mEncode == UTF8)
+			return mText;
+		return utf16_to_utf8((const uint8_t*) mText.data(), mText.size());
+	}
+
+	/**
+	 * Change the text content, converting it to the record encoding.
+	 * @param text New text to store, encoded as UTF8.
+	 */
+	void set_text_utf8(const std::string &text) {
+		set_text(mEncode == UTF8 ? text : utf8_to_utf16(text));
+	}
+
 	/**
 	 * Get the language used in the text.
 	 * @return Language used in the text.
@@ -135,6 +162,29 @@ public:
 
 	}
 
+	/**
+	 * Compare the record language with a language code, ignoring the case.
+	 * @param language Language code.
+	 * @return how much the 2 languages are similar
+	 */
+	LanguageMatch_t match_language(const std::string &language) const;
+
+	/**
+	 * Convert a UTF8 string to UTF16.
+	 * @param text UTF8 text, a not valid sequence is replaced by U+FFFD.
+	 * @return UTF16 text, big endian without byte order mark
+	 */
+	static std::string utf8_to_utf16(const std::string &text);
+
+	/**
+	 * Convert a UTF16 text to UTF8.
+	 * @par Without a byte order mark the text is read as big endian.
+	 * @param text UTF16 text.
+	 * @param length Text length in bytes.
+	 * @return UTF8 text, a not valid sequence is replaced by U+FFFD
+	 */
+	static std::string utf16_to_utf8(const uint8_t *text, uint32_t length);
+
 	virtual uint16_t write(uint8_t *buffer);
 	virtual ~RecordText() {	};
 
@@ -156,7 +206,7 @@ private:
 			const std::string &language) {
 		uint8_t status = language.size();
 		if (enc == UTF16) {
-			status &= 0x80; // set to 1 the bit 7
+			status |= 0x80; // set to 1 the bit 7
 		} //if
 		return status;
 	} //getTextStatus
@@ -52,9 +52,48 @@ const std::string RecordURI::sKnowUriPrefix[] = { "", "http://www.",
 		"smb://", "nfs://", "ftp://", "dav://", "news:", "telnet://", "imap:",
 		"rtsp://", "urn:", "pop:", "sip:", "sips:", "tftp:", "btspp://",
 		"btl2cap://", "btgoep://", "tcpobex://", "irdaobex://", "file://",
-		"urn:epc:id:", "urn:epc:tag", "urn:epc:pat:", "urn:epc:raw:",
+		"urn:epc:id:", "urn:epc:tag:", "urn:epc:pat:", "urn:epc:raw:",
 		"urn:epc:", "urn:nfc:" };
 
+const uint8_t RecordURI::sSortedUriPrefix[] = { BTGOEP, BTL2CAP, BTSPP, DAV,
+		FILE, FTP, FTP_ANONIMUS, FTP_FTP, FTPS, HTTP, HTTP_WWW, HTTPS,
+		HTTPS_WWW, IMAP, IRDAOBEX, MAIL, NEWS, NFS, POP, RTSP, SFTP, SIP, SIPS,
+		SMB, TCPOBEX, TEL, TELNET, TFTP, URN, URN_EPC, URN_EPC_ID, URN_EPC_PAT,
+		URN_EPC_RAW, URN_EPC_TAG, URN_NFC };
+
+RecordURI::knowUriId_t RecordURI::find_uri_prefix(const char *uri,
+		uint16_t length) {
+	if (length == 0)
+		return UNKNOWN;
+
+	//search the last prefix that is lower or equal to the uri
+	int16_t first = 0;
+	int16_t last = sizeof(sSortedUriPrefix) - 1;
+	int16_t found = -1;
+	while (first <= last) {
+		const int16_t middle = (first + last) / 2;
+		if (sKnowUriPrefix[sSortedUriPrefix[middle]].compare(0,
+				std::string::npos, uri, length) <= 0) {
+			found = middle;
+			first = middle + 1;
+		} else
+			last = middle - 1;
+	} //while
+
+	//a longer prefix is greater than the shorter ones, so the first prefix found
+	//moving backward is the longest one
+	for (; found >= 0; found--) {
+		const std::string &prefix = sKnowUriPrefix[sSortedUriPrefix[found]];
+		if (prefix[0] != uri[0])
+			break;
+		if (prefix.size() <= length
+				&& prefix.compare(0, prefix.size(), uri, prefix.size()) == 0)
+			return (knowUriId_t) sSortedUriPrefix[found];
+	} //for
+
+	return UNKNOWN;
+}
+
 void RecordURI::set_record_header() {
 	mRecordHeader.set_FNT(RecordHeader::NFC_well_known);
 	mRecordHeader.set_type_length(sizeof(sNDEFUriIdCode));
@@ -62,24 +101,31 @@ void RecordURI::set_record_header() {
 }
 
 RecordURI::RecordURI(knowUriId_t uriId, const std::string &uriContent) :
-		mUriTypeId(uriId), mTypeString("") {
+		mUriTypeId(uriId != UNKNOWN ? uriId : find_uri_prefix(uriContent)),
+		mTypeString("") {
 	set_content(uriContent);
 	set_record_header();
 }
 
 RecordURI::RecordURI(const std::string &uriType, const std::string &uriContent) :
-		mContent(uriContent),mUriTypeId(UNKNOWN), mTypeString(uriType)  {
+		mContent(uriType+uriContent),mUriTypeId(find_uri_prefix(mContent)),
+		mTypeString(mUriTypeId==UNKNOWN ? uriType : "")  {
+	if (mUriTypeId != UNKNOWN)
+		mContent.erase(0, sKnowUriPrefix[mUriTypeId].size());
+	else
+		mContent = uriContent;
 	update_record_header();
 	set_record_header();
 }
 
 uint16_t RecordURI::write(uint8_t *buffer) {
 	uint16_t offset = 0;
-	update_content();
+	update_content_and_header();
 
 	offset += mRecordHeader.write_header(buffer);
 
 	buffer[offset++] = sNDEFUriIdCode;
+	offset += write_id(buffer + offset);
 	buffer[offset++] = (uint8_t) mUriTypeId;
 
 	if (mUriTypeId == UNKNOWN) {
@@ -96,19 +142,31 @@ RecordURI* RecordURI::parse(const RecordHeader &header,
 		const uint8_t *buffer) {
 	uint16_t offset = 0;
 
+	if (header.get_FNT() != RecordHeader::NFC_well_known
+			|| header.get_type_length() != 1 || header.get_payload_length() == 0)
+		return NULL;
 	if (buffer[offset++] != sNDEFUriIdCode)
 		return NULL;
+	offset += header.get_id_length();
 	knowUriId_t uriType = (knowUriId_t) buffer[offset++];
+	//the reserved id must be handled as an uri without prefix
+	if (uriType >= N_KNOW_URI_PREFIX)
+		uriType = UNKNOWN;
 	//it is a standard type handle by a specific class
 	if (uriType == MAIL) {
-		return RecordMail::parse(header, buffer);
+		RecordURI *r = RecordMail::parse(header, buffer);
+		if (r != NULL)
+			return r;
 	} //if
 
 	//is an standard type without a specific class
 	if (uriType != UNKNOWN) {
-		return new RecordURI(uriType,
-				std::string((const char*) buffer + offset,
-						header.get_payload_length() - 1));
+		//the content is already without prefix: copy it without going through set_content
+		RecordURI *r = new RecordURI(uriType);
+		r->mContent.assign((const char*) buffer + offset,
+				header.get_payload_length() - 1);
+		r->update_record_header();
+		return r;
 	} //else
 
 	//is an unknown type with a specific class
@@ -119,9 +177,11 @@ RecordURI* RecordURI::parse(const RecordHeader &header,
 	if (r != NULL)
 		return r;
 	//else is an unknown type without a specific class
-	return new RecordURI(uriType,
-			std::string((const char*) buffer + offset,
-					header.get_payload_length() - 1));
+	r = new RecordURI(std::string());
+	r->mContent.assign((const char*) buffer + offset,
+			header.get_payload_length() - 1);
+	r->update_record_header();
+	return r;
 
 }
 
@@ -108,6 +108,8 @@ public:
 	 * @param URIId URI type.
 	 * @param URIContent URI content.
 	 * @par The URI prefix is removed.
+	 * @par If URIId is {@code UNKNOWN} the longest known prefix of URIContent is
+	 * selected, so the URI is stored with the shortest abbreviation.
 	 * @par The string is copied inside the class.
 	 */
 	explicit RecordURI(knowUriId_t URIId, const std::string &URIContent="");
@@ -116,6 +118,8 @@ public:
 	 * Build a custom URI type.
 	 * @param URIType string with the URI type.
 	 * @param URIContent URI content.
+	 * @par If URIType + URIContent starts with a known prefix, the record is
+	 * stored with the corresponding URI id instead of the type string.
 	 */
 	explicit RecordURI(const std::string &URIType, const std::string &URIContent="");
 
@@ -135,7 +139,7 @@ public:
 		return mUriTypeId;
 	}
 
-	virtual uint16_t get_byte_length() {
+	virtual uint32_t get_byte_length() {
 		update_content_and_header();
 		return mRecordHeader.get_record_length();
 	}
@@ -170,6 +174,34 @@ public:
 		return mTypeString;
 	}
 
+	/**
+	 * Get the string that precedes the content in the complete URI.
+	 * @return prefix of the URI id or the user URI type if the id is {@code UNKNOWN}
+	 * @par The complete URI is get_uri_prefix() followed by get_content().
+	 */
+	const std::string& get_uri_prefix() const {
+		if(mUriTypeId!=UNKNOWN)
+			return sKnowUriPrefix[mUriTypeId];
+		return mTypeString;
+	}
+
+	/**
+	 * Search the longest known prefix that starts the URI.
+	 * @param uri URI to check.
+	 * @param length Number of characters of the URI.
+	 * @return id of the longest matching prefix, {@code UNKNOWN} if no prefix matches
+	 */
+	static knowUriId_t find_uri_prefix(const char *uri, uint16_t length);
+
+	/**
+	 * Search the longest known prefix that starts the URI.
+	 * @param uri URI to check.
+	 * @return id of the longest matching prefix, {@code UNKNOWN} if no prefix matches
+	 */
+	static knowUriId_t find_uri_prefix(const std::string &uri){
+		return find_uri_prefix(uri.data(),uri.size());
+	}
+
 	bool operator==(const RecordURI &other) const {
 		return 	(mUriTypeId==other.mUriTypeId) &&
 				(mTypeString==other.mTypeString) &&
@@ -227,7 +259,7 @@ private:
 	void store_removeing_prefix(const std::string &prefix,const std::string &content){
 		//check that the content doens't contain the prefix
 		if (content.compare(0, prefix.size(), prefix) == 0) {
-			mContent = std::string(content, prefix.size());
+			mContent.assign(content, prefix.size(), std::string::npos);
 		} else
 			mContent = content;
 	}
@@ -247,6 +279,16 @@ private:
 	 * Array of known prefix of known URI type
 	 */
 	static const std::string sKnowUriPrefix[];
+
+	/**
+	 * Number of URI id with a prefix
+	 */
+	static const uint8_t N_KNOW_URI_PREFIX = URN_NFC+1;
+
+	/**
+	 * Id of the known URI prefix, sorted by prefix in lexicographic order
+	 */
+	static const uint8_t sSortedUriPrefix[];
 };
 
 } /* namespace NDefLib */
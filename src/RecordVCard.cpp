@@ -34,6 +34,7 @@
  *
  ******************************************************************************
  */
+#include <cctype>
 #include <cstring>
 #include "RecordVCard.h"
 
@@ -57,91 +58,422 @@ const std::string RecordVCard::sEndVCardTag("END:VCARD");
 
 RecordVCard::RecordVCard(const VCardInfo_t &info) :
 		RecordMimeType(sVcardMimeType), mCardInfo(info),mContentIsChange(true) {
-	update_content_info_string();
+	update_payload_length();
 }
 
-void RecordVCard::update_content_info_string() {
+void RecordVCard::update_payload_length() {
 	if(!mContentIsChange)
 		return;
 
-	mCardInfoString = sStartVCardTag;
+	uint32_t length = sStartVCardTag.size() + sEndVCardTag.size();
 
 	VCardInfo_t::const_iterator it = mCardInfo.begin();
 	VCardInfo_t::const_iterator end = mCardInfo.end();
 
 	for (; it != end; ++it) {
-		mCardInfoString += sStartFieldTag[it->first];
-		mCardInfoString += it->second;
-		mCardInfoString += sEndFieldTag;
+		length += sStartFieldTag[it->first].size() + it->second.size()
+				+ sEndFieldTag.size();
 	} //for
 
-	mCardInfoString += sEndVCardTag;
-
-	set_mime_data_pointer((uint8_t*)mCardInfoString.data(),mCardInfoString.size());
+	set_generated_data_length(length);
 
 	mContentIsChange=false;
+}
 
+/**
+ * Copy a string in the buffer.
+ * @return number of bytes written
+ */
+static uint32_t write_string(uint8_t *buffer, const std::string &str) {
+	std::memcpy(buffer, str.data(), str.size());
+	return str.size();
 }
 
-uint16_t RecordVCard::find_VCard_field_data_lenght(const std::string &content,
-		uint16_t offset) {
-	std::size_t pos = content.find(sEndFieldTag, offset);
-	if (pos == std::string::npos) { //if we don't find the end, lets consume all the content
-		return content.size() - offset;
-	} //else
-	return content.find(sEndFieldTag, offset) - offset;
-} //findVCardFieldDataLenght
-
-int8_t RecordVCard::find_VCard_field_type(const std::string &content,
-		uint16_t offset) {
-	const uint32_t nFieldTag = sizeof(sStartFieldTag)
-			/ sizeof(sStartFieldTag[0]);
-	for (uint32_t i = 0; i < nFieldTag; i++) {
-		if (content.find(sStartFieldTag[i], offset) != std::string::npos)
-			return i;
+uint16_t RecordVCard::write(uint8_t *buffer) {
+	update_payload_length();
+
+	uint16_t offset = mRecordHeader.write_header(buffer);
+	offset += write_string(buffer + offset, get_mime_type());
+	offset += write_id(buffer + offset);
+	offset += write_string(buffer + offset, sStartVCardTag);
+
+	VCardInfo_t::const_iterator it = mCardInfo.begin();
+	VCardInfo_t::const_iterator end = mCardInfo.end();
+
+	for (; it != end; ++it) {
+		offset += write_string(buffer + offset, sStartFieldTag[it->first]);
+		offset += write_string(buffer + offset, it->second);
+		offset += write_string(buffer + offset, sEndFieldTag);
 	} //for
+
+	offset += write_string(buffer + offset, sEndVCardTag);
+	return offset;
+}
+
+/**
+ * Flags set by the property parameters
+ */
+typedef enum {
+	PARAM_HOME = 0x01,
+	PARAM_WORK = 0x02,
+	PARAM_CELL = 0x04,
+	PARAM_BASE64 = 0x08,
+	PARAM_URI = 0x10,
+	PARAM_QUOTED_PRINTABLE = 0x20,
+} VCardParam_t;
+
+/**
+ * Vcard properties, sorted by name. The field is refined using the parameters.
+ */
+static const struct {
+	const char *name;
+	RecordVCard::VCardField_t field;
+} sVCardProperty[] = {
+	{ "ADR", RecordVCard::ADDRESS },
+	{ "AGENT", RecordVCard::AGENT },
+	{ "BDAY", RecordVCard::BIRDAY },
+	{ "CATEGORIES", RecordVCard::CATEGORIES },
+	{ "EMAIL", RecordVCard::EMAIL },
+	{ "FN", RecordVCard::FORMATTED_NAME },
+	{ "GEO", RecordVCard::GEO },
+	{ "IMPP", RecordVCard::IMPP },
+	{ "KEY", RecordVCard::PGPKEY_URL },
+	{ "LOGO", RecordVCard::LOGO },
+	{ "N", RecordVCard::NAME },
+	{ "NICKNAME", RecordVCard::NICKNAME },
+	{ "NOTE", RecordVCard::NOTE },
+	{ "ORG", RecordVCard::ORGANIZATION },
+	{ "PHOTO", RecordVCard::PHOTO_URI },
+	{ "REV", RecordVCard::REVISION },
+	{ "SOURCE", RecordVCard::SOURCE_URL },
+	{ "TEL", RecordVCard::TEL },
+	{ "TITLE", RecordVCard::TITLE },
+	{ "URL", RecordVCard::URL },
+};
+
+/**
+ * Compare a string with an upper case string, ignoring the case.
+ * @param str String to compare, not null terminated.
+ * @param length Length of str.
+ * @param upperCase Null terminated upper case string.
+ * @return <0, 0 or >0 as strcmp
+ */
+static int compare_ignore_case(const char *str, uint32_t length,
+		const char *upperCase) {
+	for (uint32_t i = 0; i < length; i++) {
+		if (upperCase[i] == '\0') //str is longer
+			return 1;
+		const int diff = toupper((unsigned char) str[i])
+				- (unsigned char) upperCase[i];
+		if (diff != 0)
+			return diff;
+	} //for
+	return -(unsigned char) upperCase[length];
+}
+
+/**
+ * Find the end of the line.
+ * @param[in,out] pos Start of the line, it is moved to the start of the next line.
+ * @param end End of the buffer.
+ * @return pointer to the line end, without the line terminator
+ */
+static const char* next_line(const char *&pos, const char *end) {
+	const char *lineStart = pos;
+	const char *lineEnd = (const char*) memchr(pos, '\n', end - pos);
+	if (lineEnd == NULL) {
+		pos = end;
+		return end;
+	} //if
+	pos = lineEnd + 1;
+	if (lineEnd > lineStart && lineEnd[-1] == '\r')
+		return lineEnd - 1;
+	return lineEnd;
+}
+
+/**
+ * Search the property name in sVCardProperty.
+ * @return the property field or -1 if it is unknown
+ */
+static int8_t find_property(const char *name, uint32_t length) {
+	int8_t first = 0;
+	int8_t last = sizeof(sVCardProperty) / sizeof(sVCardProperty[0]) - 1;
+	while (first <= last) {
+		const int8_t middle = (first + last) / 2;
+		const int cmp = compare_ignore_case(name, length,
+				sVCardProperty[middle].name);
+		if (cmp == 0)
+			return sVCardProperty[middle].field;
+		if (cmp < 0)
+			last = middle - 1;
+		else
+			first = middle + 1;
+	} //while
 	return -1;
-} //findVCardFieldType
+}
+
+/**
+ * Convert a parameter value into a VCardParam_t flag.
+ * @return the flag or 0 if the value is not used by this record
+ */
+static uint8_t get_param_flag(const char *value, uint32_t length) {
+	if (compare_ignore_case(value, length, "HOME") == 0)
+		return PARAM_HOME;
+	if (compare_ignore_case(value, length, "WORK") == 0)
+		return PARAM_WORK;
+	if (compare_ignore_case(value, length, "CELL") == 0)
+		return PARAM_CELL;
+	if (compare_ignore_case(value, length, "B") == 0
+			|| compare_ignore_case(value, length, "BASE64") == 0)
+		return PARAM_BASE64;
+	if (compare_ignore_case(value, length, "URI") == 0
+			|| compare_ignore_case(value, length, "URL") == 0)
+		return PARAM_URI;
+	if (compare_ignore_case(value, length, "QUOTED-PRINTABLE") == 0)
+		return PARAM_QUOTED_PRINTABLE;
+	return 0;
+}
+
+/**
+ * Read the property parameters: "TYPE=home,pref;ENCODING=b" (3.0/4.0) or
+ * "HOME;ENCODING=QUOTED-PRINTABLE" (2.1).
+ * @param params Parameters, without the first ';'.
+ * @param length Parameters length.
+ * @param[out] otherParams Parameters different from the encoding one.
+ * @return VCardParam_t flags
+ */
+static uint8_t parse_params(const char *params, uint32_t length,
+		std::string &otherParams) {
+	uint8_t flags = 0;
+	const char *end = params + length;
+	while (params < end) {
+		const char *paramEnd = (const char*) memchr(params, ';', end - params);
+		if (paramEnd == NULL)
+			paramEnd = end;
+		const char *value = (const char*) memchr(params, '=',
+				paramEnd - params);
+		const bool isEncoding = value != NULL
+				&& compare_ignore_case(params, value - params, "ENCODING") == 0;
+		value = value == NULL ? params : value + 1;
+		uint8_t paramFlags = 0;
+		//the value can be a list: TYPE="home,voice"
+		while (value < paramEnd) {
+			const char *valueEnd = (const char*) memchr(value, ',',
+					paramEnd - value);
+			if (valueEnd == NULL)
+				valueEnd = paramEnd;
+			const char *first = value;
+			const char *last = valueEnd;
+			if (first < last && *first == '"')
+				first++;
+			if (first < last && last[-1] == '"')
+				last--;
+			paramFlags |= get_param_flag(first, last - first);
+			value = valueEnd + 1;
+		} //while
+		if (!isEncoding && (paramFlags & PARAM_BASE64) == 0) {
+			if (!otherParams.empty())
+				otherParams += ';';
+			otherParams.append(params, paramEnd - params);
+		} //if
+		flags |= paramFlags;
+		params = paramEnd + 1;
+	} //while
+	return flags;
+}
+
+/**
+ * Find the record field from the property and its parameters.
+ */
+static RecordVCard::VCardField_t get_field(RecordVCard::VCardField_t property,
+		uint8_t flags) {
+	switch (property) {
+	case RecordVCard::ADDRESS:
+		if (flags & PARAM_HOME)
+			return RecordVCard::ADDRESS_HOME;
+		if (flags & PARAM_WORK)
+			return RecordVCard::ADDRESS_WORK;
+		return property;
+	case RecordVCard::EMAIL:
+		if (flags & PARAM_HOME)
+			return RecordVCard::EMAIL_HOME;
+		if (flags & PARAM_WORK)
+			return RecordVCard::EMAIL_WORK;
+		return property;
+	case RecordVCard::TEL:
+		if (flags & PARAM_CELL)
+			return RecordVCard::TEL_MOBILE;
+		if (flags & PARAM_HOME)
+			return RecordVCard::TEL_HOME;
+		if (flags & PARAM_WORK)
+			return RecordVCard::TEL_WORK;
+		return property;
+	case RecordVCard::PGPKEY_URL:
+		if (flags & PARAM_BASE64)
+			return RecordVCard::PGPGKEY_BASE64;
+		return property;
+	case RecordVCard::LOGO:
+		if (flags & PARAM_BASE64)
+			return RecordVCard::LOGO_BASE64;
+		if (flags & PARAM_URI)
+			return RecordVCard::LOGO_URI;
+		return property;
+	case RecordVCard::PHOTO_URI: //in 4.0 the photo is always an uri
+		if (flags & PARAM_BASE64)
+			return RecordVCard::PHOTO_BASE64;
+		return property;
+	default:
+		return property;
+	} //switch
+}
+
+/**
+ * @return the value of an hex digit or -1
+ */
+static int8_t hex_value(char c) {
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	c = toupper((unsigned char) c);
+	if (c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	return -1;
+}
+
+/**
+ * Decode a quoted printable value (vcard 2.1).
+ * @param value Encoded value, without soft line breaks.
+ * @param length Value length.
+ * @param[out] out String where append the decoded value.
+ */
+static void decode_quoted_printable(const char *value, uint32_t length,
+		std::string &out) {
+	out.reserve(out.size() + length);
+	for (uint32_t i = 0; i < length; i++) {
+		if (value[i] == '=' && i + 2 < length && hex_value(value[i + 1]) >= 0
+				&& hex_value(value[i + 2]) >= 0) {
+			out += (char) ((hex_value(value[i + 1]) << 4)
+					| hex_value(value[i + 2]));
+			i += 2;
+		} else
+			out += value[i];
+	} //for
+}
+
+bool RecordVCard::parse_content(const char *content, uint32_t length,
+		VCardInfo_t &info) {
+	const char *pos = content;
+	const char *end = content + length;
+	std::string unfolded; //used only for the lines that continue on the next ones
+	bool isStarted = false;
+
+	while (pos < end) {
+		const char *line = pos;
+		const char *lineEnd = next_line(pos, end);
+
+		//a line starting with a space or a tab continues the previous one
+		if (pos < end && (*pos == ' ' || *pos == '\t')) {
+			unfolded.assign(line, lineEnd - line);
+			while (pos < end && (*pos == ' ' || *pos == '\t')) {
+				const char *next = pos + 1;
+				const char *nextEnd = next_line(pos, end);
+				unfolded.append(next, nextEnd - next);
+			} //while
+			line = unfolded.data();
+			lineEnd = line + unfolded.size();
+		} //if
+
+		//line format: [group.]name[;params]:value
+		const char *value = (const char*) memchr(line, ':', lineEnd - line);
+		if (value == NULL) //not a property
+			continue;
+		const char *params = (const char*) memchr(line, ';', value - line);
+		const char *nameEnd = params == NULL ? value : params;
+		const char *name = line;
+		for (const char *c = line; c < nameEnd; c++) {
+			if (*c == '.')
+				name = c + 1;
+		} //for
+		const uint32_t nameLength = nameEnd - name;
+		value++;
+		const uint32_t valueLength = lineEnd - value;
+
+		if (!isStarted) { //the first property must be BEGIN:VCARD
+			if (compare_ignore_case(name, nameLength, "BEGIN") != 0
+					|| compare_ignore_case(value, valueLength, "VCARD") != 0)
+				return false;
+			isStarted = true;
+			continue;
+		} //if
+
+		if (compare_ignore_case(name, nameLength, "END") == 0)
+			break;
+
+		if (compare_ignore_case(name, nameLength, "VERSION") == 0) {
+			if (compare_ignore_case(value, valueLength, "2.1") != 0
+					&& compare_ignore_case(value, valueLength, "3.0") != 0
+					&& compare_ignore_case(value, valueLength, "4.0") != 0)
+				return false;
+			continue;
+		} //if
+
+		const int8_t property = find_property(name, nameLength);
+		if (property < 0) //unknown property, skip it
+			continue;
+
+		std::string otherParams;
+		const uint8_t flags = params == NULL ? 0 :
+				parse_params(params + 1, value - 1 - (params + 1), otherParams);
+		const VCardField_t field = get_field((VCardField_t) property, flags);
+
+		std::string &fieldValue = info[field];
+		fieldValue.clear();
+		if (field == LOGO_BASE64 || field == PHOTO_BASE64) {
+			//the parameters are part of the field value: TYPE=XXXX:imagebyte
+			fieldValue = otherParams;
+			fieldValue += ':';
+		} //if
+
+		if ((flags & PARAM_QUOTED_PRINTABLE) == 0) {
+			fieldValue.append(value, valueLength);
+			continue;
+		} //if
+
+		//a quoted printable value ending with '=' continues in the next line
+		if (valueLength == 0 || value[valueLength - 1] != '=' || pos >= end) {
+			decode_quoted_printable(value, valueLength, fieldValue);
+			continue;
+		} //if
+		std::string encoded(value, valueLength - 1);
+		while (pos < end) {
+			const char *next = pos;
+			const char *nextEnd = next_line(pos, end);
+			if (next < nextEnd && nextEnd[-1] == '=') {
+				encoded.append(next, nextEnd - next - 1);
+			} else {
+				encoded.append(next, nextEnd - next);
+				break;
+			} //if-else
+		} //while
+		decode_quoted_printable(encoded.data(), encoded.size(), fieldValue);
+	} //while
+
+	return isStarted;
+}
 
 RecordVCard* RecordVCard::parse(const RecordHeader &header,
 		const uint8_t* buffer) {
-	if (header.get_FNT() != RecordHeader::Mime_media_type
-			|| header.get_type_length() != sVcardMimeType.size()) {
+	if (header.get_FNT() != RecordHeader::Mime_media_type)
 		return NULL;
-	} //else
-	if (sVcardMimeType.compare(0, sVcardMimeType.size(), (const char*) buffer,
-			sVcardMimeType.size()) != 0) {
+	//else
+	const uint8_t typeLength = header.get_type_length();
+	if (compare_ignore_case((const char*) buffer, typeLength, "TEXT/VCARD") != 0
+			&& compare_ignore_case((const char*) buffer, typeLength,
+					"TEXT/X-VCARD") != 0)
 		return NULL;
-	}
-	buffer += header.get_type_length();
+	buffer += typeLength + header.get_id_length();
 	//we are at the start of the vcard data
-	if (sStartVCardTag.compare(0, sStartVCardTag.size(), (const char*) (buffer),
-			sStartVCardTag.size()) != 0)
-		return NULL;
-	//the version is ok
-	const std::string vCardContent((const char*) buffer + sStartVCardTag.size(),
-			header.get_payload_length() - sStartVCardTag.size());
-	uint16_t offset = 0;
-	buffer += sStartVCardTag.size(); // for debug
 	VCardInfo_t info;
-	do {
-		const int8_t type = find_VCard_field_type(vCardContent, offset);
-
-		if (type >= 0) { //if is a valid type
-			const VCardField_t fieldType = (VCardField_t) type;
-			offset += sStartFieldTag[fieldType].size(); // skip the tag name
-			//search the tag size
-			const uint16_t length = find_VCard_field_data_lenght(vCardContent,
-					offset);
-			info[fieldType] = vCardContent.substr(offset, length);
-			offset += length + sEndFieldTag.size();
-		} else {
-			//unknow field, skip until next one
-			offset += find_VCard_field_data_lenght(vCardContent, offset)
-					+ sEndFieldTag.size();
-		}
-
-	} while (offset < vCardContent.size());
+	if (!parse_content((const char*) buffer, header.get_payload_length(), info))
+		return NULL;
 
 	return new RecordVCard(info);
 }
@@ -46,7 +46,9 @@ namespace NDefLib {
 
 /**
  * Specialize the {@link RecordMimeType} to store VCard information.
- * This record handles the VCard version 3 format.
+ * This record writes the VCard version 3 format, it reads the versions 2.1, 3.0 and 4.0.
+ * @par The vcard text is generated directly inside the output buffer by {@link RecordVCard#write},
+ * so {@link RecordMimeType#get_mime_data} returns NULL for this record.
  * @see https://en.wikipedia.org/wiki/VCard
  */
 class RecordVCard: public RecordMimeType {
@@ -145,21 +147,18 @@ public:
 	 * @return update the record content and return the number of
 	 * bytes needed to store this record
 	 */
-	virtual uint16_t get_byte_length() {
-		update_content_info_string();
+	virtual uint32_t get_byte_length() {
+		update_payload_length();
 		return RecordMimeType::get_byte_length();
 	}
 
 	/**
-	 * Update the content and write it on the buffer.
+	 * Write the record header and the vcard text on the buffer.
 	 * @param[out] buffer buffer to write the record content into.
 	 * @return number of bytes written
 	 * @see Record#write
 	 */
-	virtual uint16_t write(uint8_t *buffer){
-		update_content_info_string();
-		return RecordMimeType::write(buffer);
-	}
+	virtual uint16_t write(uint8_t *buffer);
 
 	/**
 	 * Compare two objects.
@@ -175,34 +174,22 @@ public:
 private:
 	VCardInfo_t mCardInfo;
 
-	std::string mCardInfoString; ///< buffer containing the Vcard representation for this record
-
-	bool mContentIsChange; ///< true if we have to upadte the string rappresentation of the data
-
-	/**
-	 * Generate a string representing the vcard info
-	 */
-	void update_content_info_string();
+	bool mContentIsChange; ///< true if we have to update the payload length
 
 	/**
-	 * Check if the string that starts from the offset position is a valid
-	 * vcard field.
-	 * @param content String to search into.
-	 * @param offset Search offset.
-	 * @return type index of the found field or a negative number if not a valid vcard
+	 * Compute the length of the vcard text and store it in the record header
 	 */
-	static int8_t find_VCard_field_type(const std::string &content,
-			uint16_t offset);
+	void update_payload_length();
 
 	/**
-	 * Return the lenght of a vcard field.
-	 * @param Content string to search into.
-	 * @param Offset search offset.
-	 * @return field length
-	 * @par This function searches the first sEndVCardTag appearance.
+	 * Read the vcard fields, the content is read only once, line by line.
+	 * @param content VCard data.
+	 * @param length Length of the data.
+	 * @param[out] info Map where store the read fields.
+	 * @return false if the content is not a valid vcard
 	 */
-	static uint16_t find_VCard_field_data_lenght(const std::string &content,
-			uint16_t offset);
+	static bool parse_content(const char *content, uint32_t length,
+			VCardInfo_t &info);
 
 	static const std::string sVcardMimeType;
 	static const std::string sStartFieldTag[];
@@ -34,7 +34,7 @@
  *
  ******************************************************************************
  */
-#include <algorithm>
+#include <cstring>
 
 #include <RecordWifiConf.h>
 namespace NDefLib {
@@ -47,98 +47,351 @@ const RecordWifiConf::fieldType_t RecordWifiConf::sSsidField_id = 0x1045;
 const RecordWifiConf::fieldType_t RecordWifiConf::sNetworkKeyField_id = 0x1027;
 const RecordWifiConf::fieldType_t RecordWifiConf::sAuthTypeField_id = 0x1003;
 const RecordWifiConf::fieldType_t RecordWifiConf::sEncTypeField_id = 0x100F;
+const RecordWifiConf::fieldType_t RecordWifiConf::sMacAddressField_id = 0x1020;
+const RecordWifiConf::fieldType_t RecordWifiConf::sVendorExtensionField_id = 0x1049;
+const RecordWifiConf::fieldType_t RecordWifiConf::sOtherAttribute_id = 0x0000;
+
+//type + length
+#define ATTRIBUTE_HEADER_LENGTH 4
+
+//flags of the credential attributes already written
+#define WRITTEN_NETWORK_ID 0x01
+#define WRITTEN_SSID 0x02
+#define WRITTEN_AUTH_TYPE 0x04
+#define WRITTEN_ENC_TYPE 0x08
+#define WRITTEN_NETWORK_KEY 0x10
+#define WRITTEN_MAC_ADDRESS 0x20
+
+RecordWifiConf::WifiCredential_t::WifiCredential_t(const std::string &ssid,
+		const std::string &pass, authType_t authType, encryptionType_t encType):
+				networkIndex(sDefaultNetworkId),
+				ssid(ssid),
+				networkKey(pass),
+				authType(authType),
+				encType(encType),
+				hasMacAddress(false){
+	std::memset(macAddress,0,MAC_ADDRESS_LENGTH);
+}
+
+void RecordWifiConf::WifiCredential_t::set_mac_address(const uint8_t *mac){
+	std::memcpy(macAddress,mac,MAC_ADDRESS_LENGTH);
+	hasMacAddress=true;
+}
+
+bool RecordWifiConf::WifiCredential_t::operator==(const WifiCredential_t &other) const{
+	return (networkIndex==other.networkIndex) &&
+		   (ssid==other.ssid) &&
+		   (networkKey==other.networkKey) &&
+		   (authType==other.authType) &&
+		   (encType==other.encType) &&
+		   (hasMacAddress==other.hasMacAddress) &&
+		   (!hasMacAddress || std::memcmp(macAddress,other.macAddress,MAC_ADDRESS_LENGTH)==0) &&
+		   (vendorExtensions==other.vendorExtensions) &&
+		   (otherAttributes==other.otherAttributes);
+}
 
 RecordWifiConf::RecordWifiConf(const std::string &ssid,const std::string &pass,
 		authType_t authType,encryptionType_t encType):
 				RecordMimeType(sWifiConfMimeType),
-				mSsid(ssid),
-				mPasskey(pass),
-				mAuthType(authType),
-				mEncType(encType),
-				mContentIsChange(true),
-				mMimeData(NULL),
-				mMimeDataLenght(0){}
+				mCredentials(1,WifiCredential_t(ssid,pass,authType,encType)),
+				mContentIsChange(true){}
+
+RecordWifiConf::RecordWifiConf(const WifiCredential_t &credential):
+				RecordMimeType(sWifiConfMimeType),
+				mCredentials(1,credential),
+				mContentIsChange(true){}
 
 /**
- * move the data into the buffer swapping the byte order
- * @param data data to write into the buffer
+ * Write a 16bit value in big endian order.
+ * @param data value to write
  * @param outBuffer buffer where write the data
-*/
-template<typename T>
-void writeBEFromLE(const T& data,uint8_t *outBuffer){
-	uint8_t *buffer = (uint8_t*)&data;
-	std::reverse_copy(buffer,buffer+sizeof(T),outBuffer);
+ */
+static void write_be16(const uint16_t data,uint8_t *outBuffer){
+	outBuffer[0]=(uint8_t)(data>>8);
+	outBuffer[1]=(uint8_t)(data & 0xFF);
 }
 
-template<typename T>
-uint32_t RecordWifiConf::write_data_field(const fieldType_t& dataType,const T& data,uint8_t  *buffer){
-	uint32_t offset=0;
-	writeBEFromLE(dataType,buffer+offset);
-	offset+=sizeof(dataType);
-	const fieldLenght_t dataSize = sizeof(T);
-	writeBEFromLE(dataSize,buffer+offset);
-	offset+=sizeof(dataSize);
-	writeBEFromLE(data,buffer+offset);
-	return offset+dataSize;
+/**
+ * Read a 16bit value stored in big endian order.
+ * @param buffer buffer where read the data
+ * @return read value
+ */
+static uint16_t read_be16(const uint8_t *buffer){
+	return (((uint16_t)buffer[0])<<8) | buffer[1];
+}
+
+/**
+ * Read the header of the attribute that starts at offset.
+ * @param buffer attribute list
+ * @param length number of bytes of the attribute list
+ * @param offset offset of the attribute
+ * @param[out] type attribute type
+ * @param[out] attributeLength attribute content length
+ * @return false if the attribute header or content exceeds the list
+ */
+static bool read_attribute_header(const uint8_t *buffer,const uint32_t length,
+		const uint32_t offset,uint16_t *type,uint16_t *attributeLength){
+	if(length-offset<ATTRIBUTE_HEADER_LENGTH)
+		return false;
+	*type = read_be16(buffer+offset);
+	*attributeLength = read_be16(buffer+offset+2);
+	return *attributeLength <= length-offset-ATTRIBUTE_HEADER_LENGTH;
+}
+
+/**
+ * Get the length of an attribute inside a list of attributes not handled.
+ * @param attributes attribute list
+ * @param offset offset of the attribute
+ * @return attribute length with its header, or the bytes left if the attribute
+ * exceeds the list
+ */
+static uint32_t get_attribute_length(const std::string &attributes,
+		const uint32_t offset){
+	const uint32_t left = attributes.size()-offset;
+	if(left<ATTRIBUTE_HEADER_LENGTH)
+		return left;
+	const uint32_t length = ATTRIBUTE_HEADER_LENGTH+
+			read_be16((const uint8_t*)attributes.data()+offset+2);
+	return length<left ? length : left;
+}
+
+/**
+ * Copy the next attribute of a list of attributes not handled.
+ * @param attributes attribute list
+ * @param[in,out] offset offset of the attribute to copy, moved to the next one
+ * @param buffer buffer where write the attribute
+ * @return number of write bytes
+ */
+static uint32_t copy_attribute(const std::string &attributes,uint32_t &offset,
+		uint8_t *buffer){
+	if(offset>=attributes.size())
+		return 0;
+	const uint32_t length = get_attribute_length(attributes,offset);
+	std::memcpy(buffer,attributes.data()+offset,length);
+	offset+=length;
+	return length;
 }
 
 uint32_t RecordWifiConf::write_data_field(const fieldType_t& dataType,
-		const char *data,const fieldLenght_t& size, uint8_t *buffer){
+		const void *data,const fieldLenght_t& size, uint8_t *buffer){
+	write_be16(dataType,buffer);
+	write_be16(size,buffer+sizeof(dataType));
+	if(data!=NULL && size!=0)
+		std::memcpy(buffer+ATTRIBUTE_HEADER_LENGTH,data,size);
+	return ATTRIBUTE_HEADER_LENGTH+size;
+}
+
+uint32_t RecordWifiConf::write_data_field(const fieldType_t& dataType,
+		const uint16_t data, uint8_t *buffer){
+	write_be16(dataType,buffer);
+	write_be16(sizeof(data),buffer+sizeof(dataType));
+	write_be16(data,buffer+ATTRIBUTE_HEADER_LENGTH);
+	return ATTRIBUTE_HEADER_LENGTH+sizeof(data);
+}
+
+uint32_t RecordWifiConf::get_credential_length(const WifiCredential_t &credential){
+	uint32_t length = ATTRIBUTE_HEADER_LENGTH+sizeof(credential.networkIndex)+
+			ATTRIBUTE_HEADER_LENGTH+credential.ssid.size()+
+			ATTRIBUTE_HEADER_LENGTH+sizeof(uint16_t)+
+			ATTRIBUTE_HEADER_LENGTH+sizeof(uint16_t)+
+			ATTRIBUTE_HEADER_LENGTH+credential.networkKey.size()+
+			credential.otherAttributes.size();
+	if(credential.hasMacAddress)
+		length+=ATTRIBUTE_HEADER_LENGTH+MAC_ADDRESS_LENGTH;
+	for(uint32_t i=0;i<credential.vendorExtensions.size();i++)
+		length+=ATTRIBUTE_HEADER_LENGTH+credential.vendorExtensions[i].size();
+	return length;
+}
+
+uint32_t RecordWifiConf::write_credential_attribute(
+		const WifiCredential_t &credential,fieldType_t type,uint8_t &written,
+		uint32_t &nextExtension,uint32_t &nextOther,uint8_t *buffer){
+	switch(type){
+		case sNetworkIdField_id:
+			if(written & WRITTEN_NETWORK_ID)
+				return 0;
+			written|=WRITTEN_NETWORK_ID;
+			return write_data_field(sNetworkIdField_id,&credential.networkIndex,
+					sizeof(credential.networkIndex),buffer);
+		case sSsidField_id:
+			if(written & WRITTEN_SSID)
+				return 0;
+			written|=WRITTEN_SSID;
+			return write_data_field(sSsidField_id,credential.ssid.data(),
+					credential.ssid.size(),buffer);
+		case sAuthTypeField_id:
+			if(written & WRITTEN_AUTH_TYPE)
+				return 0;
+			written|=WRITTEN_AUTH_TYPE;
+			return write_data_field(sAuthTypeField_id,(uint16_t)credential.authType,buffer);
+		case sEncTypeField_id:
+			if(written & WRITTEN_ENC_TYPE)
+				return 0;
+			written|=WRITTEN_ENC_TYPE;
+			return write_data_field(sEncTypeField_id,(uint16_t)credential.encType,buffer);
+		case sNetworkKeyField_id:
+			if(written & WRITTEN_NETWORK_KEY)
+				return 0;
+			written|=WRITTEN_NETWORK_KEY;
+			return write_data_field(sNetworkKeyField_id,credential.networkKey.data(),
+					credential.networkKey.size(),buffer);
+		case sMacAddressField_id:
+			if(!credential.hasMacAddress || (written & WRITTEN_MAC_ADDRESS))
+				return 0;
+			written|=WRITTEN_MAC_ADDRESS;
+			return write_data_field(sMacAddressField_id,credential.macAddress,
+					MAC_ADDRESS_LENGTH,buffer);
+		case sVendorExtensionField_id:{
+			if(nextExtension>=credential.vendorExtensions.size())
+				return 0;
+			const std::string &extension = credential.vendorExtensions[nextExtension++];
+			return write_data_field(sVendorExtensionField_id,extension.data(),
+					extension.size(),buffer);
+		}
+		default:
+			return copy_attribute(credential.otherAttributes,nextOther,buffer);
+	}//switch
+}
+
+uint32_t RecordWifiConf::write_credential(const WifiCredential_t &credential,
+		uint8_t *buffer){
 	uint32_t offset=0;
-	writeBEFromLE(dataType,buffer+offset);
-	offset+=sizeof(dataType);;
-	writeBEFromLE(size,buffer+offset);
-	offset+=sizeof(size);
-	if(data!=NULL || size!=0)
-		std::memcpy(buffer+offset,data,size);
-	return offset+size;
+	write_be16(sCredentialField_id,buffer);
+	write_be16((fieldLenght_t)get_credential_length(credential),buffer+sizeof(fieldType_t));
+	offset+=ATTRIBUTE_HEADER_LENGTH;
+
+	uint8_t written=0;
+	uint32_t nextExtension=0;
+	uint32_t nextOther=0;
+	//the read attributes keep their order, the others follow in the default order
+	for(uint32_t i=0;i<credential.attributeOrder.size();i++)
+		offset += write_credential_attribute(credential,credential.attributeOrder[i],
+				written,nextExtension,nextOther,buffer+offset);
+
+	const fieldType_t defaultOrder[] = { sNetworkIdField_id, sSsidField_id,
+			sAuthTypeField_id, sEncTypeField_id, sNetworkKeyField_id,
+			sMacAddressField_id };
+	for(uint32_t i=0;i<sizeof(defaultOrder)/sizeof(defaultOrder[0]);i++)
+		offset += write_credential_attribute(credential,defaultOrder[i],
+				written,nextExtension,nextOther,buffer+offset);
+	while(nextExtension<credential.vendorExtensions.size())
+		offset += write_credential_attribute(credential,sVendorExtensionField_id,
+				written,nextExtension,nextOther,buffer+offset);
+	while(nextOther<credential.otherAttributes.size())
+		offset += copy_attribute(credential.otherAttributes,nextOther,buffer+offset);
+	return offset;
 }
 
-void RecordWifiConf::update_mime_data(){
+void RecordWifiConf::update_payload_length(){
 	if(!mContentIsChange)
 		return;
 
-	mMimeDataLenght=sizeof(sCredentialField_id)+sizeof(fieldLenght_t)+
-			sizeof(sNetworkIdField_id)+sizeof(fieldLenght_t)+sizeof(sDefaultNetworkId)+
-			sizeof(sSsidField_id)+sizeof(fieldLenght_t)+mSsid.length()+
-			sizeof(sNetworkKeyField_id)+sizeof(fieldLenght_t)+mPasskey.length()+
-			sizeof(sAuthTypeField_id)+sizeof(fieldLenght_t)+2+
-			sizeof(sEncTypeField_id)+sizeof(fieldLenght_t)+2;
-
-	if(mMimeData!=NULL)
-		delete [] mMimeData;
-
-	mMimeData = new uint8_t[mMimeDataLenght];
-
-	uint32_t writeOffset=0;
-	writeBEFromLE(sCredentialField_id,mMimeData+writeOffset);
-	writeOffset+=sizeof(sCredentialField_id);
-	writeBEFromLE((fieldLenght_t)(mMimeDataLenght-4),mMimeData+writeOffset);
-	writeOffset+=sizeof(fieldLenght_t);
-
-	writeOffset += write_data_field(sNetworkIdField_id,sDefaultNetworkId,mMimeData+writeOffset);
-	fieldLenght_t tempLength = (fieldLenght_t)sizeof(std::string::value_type)*mSsid.length();
-	writeOffset += write_data_field(sSsidField_id,mSsid.data(),tempLength,mMimeData+writeOffset);
-	writeOffset += write_data_field(sAuthTypeField_id,(int16_t)mAuthType,mMimeData+writeOffset);
-	writeOffset += write_data_field(sEncTypeField_id,(int16_t)mEncType,mMimeData+writeOffset);
-	tempLength = (fieldLenght_t)sizeof(std::string::value_type)*mPasskey.length();
-	writeOffset += write_data_field(sNetworkKeyField_id,mPasskey.data(),tempLength,mMimeData+writeOffset);
-
-	set_mime_data_pointer(mMimeData,mMimeDataLenght);
+	uint32_t length=mOtherAttributes.size();
+	for(uint32_t i=0;i<mCredentials.size();i++)
+		length+=ATTRIBUTE_HEADER_LENGTH+get_credential_length(mCredentials[i]);
+	for(uint32_t i=0;i<mVendorExtensions.size();i++)
+		length+=ATTRIBUTE_HEADER_LENGTH+mVendorExtensions[i].size();
+
+	set_generated_data_length(length);
 	mContentIsChange=false;
 }
 
-/**
- * Read a data from a buffer, where the buffer is in little endian and we are in
- * a big endian system
- * @param buffer buffer where read the data
- * @param out pointer to the variable where store the read data
- */
-template<typename T>
-void readLEFromBE(const uint8_t *const buffer,T* out){
-	const uint32_t typeSize = sizeof(T);
-	uint8_t *outBuffer = (uint8_t*)out;
-	std::reverse_copy(buffer,buffer+typeSize,outBuffer);
+uint32_t RecordWifiConf::write_attribute(fieldType_t type,
+		uint32_t &nextCredential,uint32_t &nextExtension,uint32_t &nextOther,
+		uint8_t *buffer) const{
+	if(type==sCredentialField_id){
+		if(nextCredential>=mCredentials.size())
+			return 0;
+		return write_credential(mCredentials[nextCredential++],buffer);
+	}else if(type==sVendorExtensionField_id){
+		if(nextExtension>=mVendorExtensions.size())
+			return 0;
+		const std::string &extension = mVendorExtensions[nextExtension++];
+		return write_data_field(sVendorExtensionField_id,extension.data(),
+				extension.size(),buffer);
+	}else
+		return copy_attribute(mOtherAttributes,nextOther,buffer);
+}
+
+uint16_t RecordWifiConf::write(uint8_t *buffer){
+	update_payload_length();
+
+	uint16_t offset = mRecordHeader.write_header(buffer);
+	const std::string &mimeType = get_mime_type();
+	std::memcpy(buffer+offset,mimeType.data(),mimeType.size());
+	offset+=mimeType.size();
+	offset+=write_id(buffer+offset);
+
+	uint32_t nextCredential=0;
+	uint32_t nextExtension=0;
+	uint32_t nextOther=0;
+	//the read attributes keep their order, the others follow in the default order
+	for(uint32_t i=0;i<mAttributeOrder.size();i++)
+		offset+=write_attribute(mAttributeOrder[i],nextCredential,nextExtension,
+				nextOther,buffer+offset);
+	while(nextOther<mOtherAttributes.size())
+		offset+=copy_attribute(mOtherAttributes,nextOther,buffer+offset);
+	while(nextCredential<mCredentials.size())
+		offset+=write_attribute(sCredentialField_id,nextCredential,nextExtension,
+				nextOther,buffer+offset);
+	while(nextExtension<mVendorExtensions.size())
+		offset+=write_attribute(sVendorExtensionField_id,nextCredential,
+				nextExtension,nextOther,buffer+offset);
+	return offset;
+}
+
+bool RecordWifiConf::parse_credential(const uint8_t *buffer,uint32_t length,
+		WifiCredential_t &credential){
+	uint32_t offset=0;
+	while(offset!=length){
+		fieldType_t type;
+		fieldLenght_t dataLength;
+		if(!read_attribute_header(buffer,length,offset,&type,&dataLength))
+			return false;
+		const uint8_t *data = buffer+offset+ATTRIBUTE_HEADER_LENGTH;
+
+		credential.attributeOrder.push_back(type);
+		switch(type){
+			case sNetworkIdField_id:
+				if(dataLength!=sizeof(credential.networkIndex))
+					return false;
+				credential.networkIndex=data[0];
+				break;
+			case sSsidField_id:
+				credential.ssid.assign((const char*)data,dataLength);
+				break;
+			case sNetworkKeyField_id:
+				credential.networkKey.assign((const char*)data,dataLength);
+				break;
+			case sAuthTypeField_id:
+				if(dataLength!=sizeof(uint16_t))
+					return false;
+				credential.authType = (authType_t)read_be16(data);
+				break;
+			case sEncTypeField_id:
+				if(dataLength!=sizeof(uint16_t))
+					return false;
+				credential.encType = (encryptionType_t)read_be16(data);
+				break;
+			case sMacAddressField_id:
+				if(dataLength!=MAC_ADDRESS_LENGTH)
+					return false;
+				credential.set_mac_address(data);
+				break;
+			case sVendorExtensionField_id:
+				if(dataLength<VENDOR_ID_LENGTH)
+					return false;
+				credential.vendorExtensions.push_back(std::string((const char*)data,dataLength));
+				break;
+			default:
+				credential.attributeOrder.back()=sOtherAttribute_id;
+				credential.otherAttributes.append((const char*)buffer+offset,
+						ATTRIBUTE_HEADER_LENGTH+dataLength);
+		}//switch
+
+		offset+=ATTRIBUTE_HEADER_LENGTH+dataLength;
+	}//while
+	return true;
 }
 
 /**
@@ -163,53 +416,46 @@ RecordWifiConf* RecordWifiConf::parse(const RecordHeader &header,
 	buffer += header.get_type_length();
 	buffer += header.get_id_length();
 
-	fieldType_t type;
-	fieldLenght_t dataLength;
-
-	readLEFromBE(buffer,&type);
-	buffer+=sizeof(fieldType_t);
-	readLEFromBE(buffer,&dataLength);
-	buffer+=sizeof(fieldLenght_t);
-
-	if(type!=sCredentialField_id)
-		return NULL;
+	const uint32_t length = header.get_payload_length();
+	std::vector<WifiCredential_t> credentials;
+	std::vector<std::string> vendorExtensions;
+	std::string otherAttributes;
+	std::vector<fieldType_t> attributeOrder;
 
-	std::string ssid;
-	std::string pass;
-	authType_t authType=AUTH_OPEN;
-	encryptionType_t encType=ENC_TYPE_NONE;
-	uint16_t enumValue;
-	fieldLenght_t readData=0;
-	while(readData!=dataLength){
-		readLEFromBE(buffer+readData,&type);
-		readData+=sizeof(fieldType_t);
-		fieldLenght_t length;
-		readLEFromBE(buffer+readData,&length);
-		readData+=sizeof(fieldLenght_t);
+	uint32_t offset=0;
+	while(offset!=length){
+		fieldType_t type;
+		fieldLenght_t dataLength;
+		if(!read_attribute_header(buffer,length,offset,&type,&dataLength))
+			return NULL;
+		const uint8_t *data = buffer+offset+ATTRIBUTE_HEADER_LENGTH;
 
-		switch(type){
-			case sSsidField_id:
-				ssid.insert(0,(const char*)buffer+readData,length);
-				break;
-			case sNetworkKeyField_id:
-				pass.insert(0,(const char*)buffer+readData,length);
-				break;
-			case sAuthTypeField_id:
-				readLEFromBE(buffer+readData,&enumValue);
-				authType = (authType_t)enumValue;
-				break;
-			case sEncTypeField_id:
-				readLEFromBE(buffer+readData,&enumValue);
-				encType = (encryptionType_t)enumValue;
-				break;
-		}
+		if(type==sCredentialField_id){
+			credentials.push_back(WifiCredential_t());
+			if(!parse_credential(data,dataLength,credentials.back()))
+				return NULL;
+			attributeOrder.push_back(sCredentialField_id);
+		}else if(type==sVendorExtensionField_id && dataLength>=VENDOR_ID_LENGTH){
+			vendorExtensions.push_back(std::string((const char*)data,dataLength));
+			attributeOrder.push_back(sVendorExtensionField_id);
+		}else{
+			otherAttributes.append((const char*)buffer+offset,
+					ATTRIBUTE_HEADER_LENGTH+dataLength);
+			attributeOrder.push_back(sOtherAttribute_id);
+		}//if-else
 
-		readData+=length;
+		offset+=ATTRIBUTE_HEADER_LENGTH+dataLength;
+	}//while
 
-	}
+	if(credentials.empty())
+		return NULL;
 
-	return new RecordWifiConf(ssid,pass,authType,encType);
+	RecordWifiConf *r = new RecordWifiConf(credentials[0]);
+	r->mCredentials.swap(credentials);
+	r->mVendorExtensions.swap(vendorExtensions);
+	r->mOtherAttributes.swap(otherAttributes);
+	r->mAttributeOrder.swap(attributeOrder);
+	return r;
 }//parse
 
 }
-
@@ -38,19 +38,26 @@
 #ifndef NDEFLIB_RECORDTYPE_RECORDWIFICONF_H_
 #define NDEFLIB_RECORDTYPE_RECORDWIFICONF_H_
 
+#include <vector>
 #include <RecordMimeType.h>
 namespace NDefLib {
 
 /**
  * Specialize the {@link RecordMimeType} to store Wifi configuration information.
+ * @par The record content is a Wi-Fi Simple Config (WSC) attribute list, it can contain
+ * more than one credential, the functions without a credential index work on the first one.
+ * @par The attributes not handled by this class are kept and written back unchanged,
+ * the attributes of a parsed record are written back in the order they were read.
+ * @par The content is generated directly inside the write buffer, get_mime_data() returns NULL.
  */
 class RecordWifiConf: public NDefLib::RecordMimeType {
 public:
 
 	/**
 	 * Authentication required by the wifi network
+	 * @par The values are flags, a network can use more than one authentication.
 	 */
-	typedef enum {
+	typedef enum : uint16_t {
 		AUTH_OPEN = 0x0000, //!< no authentication
 		AUTH_WPA_PSK = 0x0002,
 		AUTH_WPA_EAP = 0x0008,
@@ -61,7 +68,7 @@ public:
 	/**
 	 * Encryption used by the network
 	 */
-	typedef enum {
+	typedef enum : uint16_t {
 		ENC_TYPE_NONE = 0x0001,     //!< no authentication
 	    ENC_TYPE_WEP = 0x0002,      //!< wep is deprecated
 	    ENC_TYPE_TKIP = 0x0004,     //!< deprecated -> only with mixed mode (0x000c)
@@ -69,11 +76,56 @@ public:
 	    ENC_TYPE_AES_TKIP = 0x000c, //!< mixed mode
 	}encryptionType_t;
 
+	/**
+	 * Number of bytes of a MAC address.
+	 */
+	static const uint8_t MAC_ADDRESS_LENGTH = 6;
+
+	/**
+	 * Number of bytes of the vendor id at the beginning of a vendor extension.
+	 */
+	static const uint8_t VENDOR_ID_LENGTH = 3;
+
+	/**
+	 * Network credential stored in the record.
+	 */
+	struct WifiCredential_t {
+		uint8_t networkIndex; ///< network index, 1 if not specified
+		std::string ssid; ///< network name
+		std::string networkKey; ///< network password
+		authType_t authType; ///< authentication used in the network
+		encryptionType_t encType; ///< encryption used in the network
+		bool hasMacAddress; ///< true if macAddress has to be written
+		uint8_t macAddress[MAC_ADDRESS_LENGTH]; ///< network MAC address
+		std::vector<std::string> vendorExtensions; ///< vendor extensions: vendor id followed by the vendor data
+		std::string otherAttributes; ///< attributes not handled by this class, encoded as WSC attributes
+		std::vector<uint16_t> attributeOrder; ///< attribute types in reading order, the missing attributes are written after them
+
+		/**
+		 * Create an open network credential.
+		 * @param ssid network name
+		 * @param pass network password
+		 * @param authType authentication used in the network
+		 * @param encType encryption used in the network
+		 */
+		WifiCredential_t(const std::string &ssid="",const std::string &pass="",
+				authType_t authType=AUTH_OPEN,encryptionType_t encType=ENC_TYPE_NONE);
+
+		/**
+		 * Set the network MAC address.
+		 * @param mac MAC address, MAC_ADDRESS_LENGTH bytes
+		 */
+		void set_mac_address(const uint8_t *mac);
+
+		bool operator==(const WifiCredential_t &other) const;
+	};
+
 	/**
 	 * Create a RecordWifiConf reading the data from the buffer.
  	 * @param header Record header.
 	 * @param buffer Buffer to read the data from.
-	 * @return an object of type RecordVCard or NULL
+	 * @return an object of type RecordWifiConf or NULL if the content is not a
+	 * valid WSC attribute list with at least one credential
 	 * @par User is in charge of freeing the pointer returned by this function.
 	 */
 	static RecordWifiConf* parse(const RecordHeader &header,
@@ -90,6 +142,12 @@ public:
 	RecordWifiConf(const std::string &ssid,const std::string &pass="",
 			authType_t authType=AUTH_OPEN,encryptionType_t encType=ENC_TYPE_NONE);
 
+	/**
+	 * Create a record with a wifi credential.
+	 * @param credential network credential
+	 */
+	explicit RecordWifiConf(const WifiCredential_t &credential);
+
     /**
      * Get the record type.
      * @return TYPE_WIFI_CONF
@@ -102,116 +160,231 @@ public:
 	 * @return update the record content and return the number of
 	 * bytes needed to store this record
 	 */
-	virtual uint16_t get_byte_length() {
-		update_mime_data();
+	virtual uint32_t get_byte_length() {
+		update_payload_length();
 		return RecordMimeType::get_byte_length();
 	}
 
 	/**
-	 * Update the content and write it on the buffer.
+	 * Write the record header and the WSC attributes on the buffer.
 	 * @param[out] buffer buffer to write the record content into.
 	 * @return number of bytes written
 	 * @see Record#write
 	 */
-	virtual uint16_t write(uint8_t *buffer){
-		update_mime_data();
-		return RecordMimeType::write(buffer);
-	}
+	virtual uint16_t write(uint8_t *buffer);
 
 	/**
 	 * Compare two objects.
-	 * @return true if the records have the same Vcard information
+	 * @return true if the records have the same credentials and attributes,
+	 * the attribute order is not compared
 	 */
 	bool operator==(const RecordWifiConf &other){
-		return (mSsid==other.mSsid) &&
-			   (mPasskey==other.mPasskey) &&
-			   (mAuthType==other.mAuthType) &&
-			   (mEncType==other.mEncType);
+		return (mCredentials==other.mCredentials) &&
+			   (mVendorExtensions==other.mVendorExtensions) &&
+			   (mOtherAttributes==other.mOtherAttributes);
 	}
 
 
 	const std::string& get_network_key() const{
-		return mPasskey;
+		return mCredentials[0].networkKey;
 	}
 
 	void set_network_key(const std::string &newKey){
-		mPasskey=newKey;
+		mCredentials[0].networkKey=newKey;
 		mContentIsChange=true;
 	}
 
 	const std::string& get_network_ssid() const{
-		return mSsid;
+		return mCredentials[0].ssid;
 	}
 
 	void set_network_ssid(const std::string &newSsid){
-		mSsid=newSsid;
+		mCredentials[0].ssid=newSsid;
 		mContentIsChange=true;
 	}
 
 	authType_t get_auth_type() const{
-		return mAuthType;
+		return mCredentials[0].authType;
 	}
 
 	void set_auth_type(const authType_t &newAuth){
-		mAuthType = newAuth;
+		mCredentials[0].authType = newAuth;
 		mContentIsChange=true;
 	}
 
 	encryptionType_t get_encryption() const{
-		return mEncType;
+		return mCredentials[0].encType;
 	}
 
 	void set_encryption_type(const encryptionType_t &newEncript){
-		mEncType =  newEncript;
+		mCredentials[0].encType =  newEncript;
 		mContentIsChange=true;
 	}
 
-	virtual ~RecordWifiConf(){
-		if(mMimeData!=NULL)
-			delete [] mMimeData;
+	/**
+	 * @return number of credentials stored in the record
+	 */
+	uint32_t get_n_credentials() const{
+		return mCredentials.size();
 	}
 
-private:
+	/**
+	 * Get a credential.
+	 * @param index credential index, must be lower than get_n_credentials()
+	 * @return the credential
+	 */
+	const WifiCredential_t& get_credential(uint32_t index) const{
+		return mCredentials[index];
+	}
 
 	/**
-	 * function that update the ndef data format
+	 * Change a credential.
+	 * @param index credential index, must be lower than get_n_credentials()
+	 * @param credential new credential
 	 */
-	void update_mime_data();
+	void set_credential(uint32_t index,const WifiCredential_t &credential){
+		mCredentials[index]=credential;
+		mContentIsChange=true;
+	}
+
+	/**
+	 * Add a credential at the end of the record.
+	 * @param credential credential to add
+	 */
+	void add_credential(const WifiCredential_t &credential){
+		mCredentials.push_back(credential);
+		mContentIsChange=true;
+	}
+
+	/**
+	 * Remove a credential, the last credential can not be removed.
+	 * @param index credential index
+	 * @return true if the credential is removed
+	 */
+	bool remove_credential(uint32_t index){
+		if(index>=mCredentials.size() || mCredentials.size()==1)
+			return false;
+		mCredentials.erase(mCredentials.begin()+index);
+		mContentIsChange=true;
+		return true;
+	}
+
+	/**
+	 * Get the vendor extensions written outside the credentials.
+	 * @return list of vendor extensions: vendor id followed by the vendor data
+	 */
+	const std::vector<std::string>& get_vendor_extensions() const{
+		return mVendorExtensions;
+	}
+
+	/**
+	 * Add a vendor extension outside the credentials.
+	 * @param vendorId vendor id, VENDOR_ID_LENGTH bytes
+	 * @param data vendor data
+	 */
+	void add_vendor_extension(const uint8_t *vendorId,const std::string &data){
+		mVendorExtensions.push_back(std::string((const char*)vendorId,VENDOR_ID_LENGTH)+data);
+		mContentIsChange=true;
+	}
+
+	/**
+	 * Remove all the vendor extensions written outside the credentials.
+	 */
+	void remove_vendor_extensions(){
+		mVendorExtensions.clear();
+		mContentIsChange=true;
+	}
+
+	virtual ~RecordWifiConf(){ }
+
+private:
 
 	typedef uint16_t fieldType_t; //< type to use for store a field type
 	typedef uint16_t fieldLenght_t; //<type to use for store a filed length
 
 	/**
-	 * write a data field into the output buffer
-	 * @param dataType field type
-	 * @param data field content
-	 * @param buffer buffer where write the data field
+	 * Compute the payload length and update the record header.
+	 */
+	void update_payload_length();
+
+	/**
+	 * Write the next attribute of a kind, each attribute is written only once.
+	 * @param credential credential that contains the attribute
+	 * @param type attribute type, sOtherAttribute_id for the attributes not handled
+	 * @param[in,out] written flags of the attributes already written
+	 * @param[in,out] nextExtension index of the next vendor extension to write
+	 * @param[in,out] nextOther offset of the next attribute not handled to write
+	 * @param buffer buffer where write the attribute
+	 * @return number of write bytes, 0 if there isn't an attribute left of that kind
+	 */
+	static uint32_t write_credential_attribute(const WifiCredential_t &credential,
+			fieldType_t type,uint8_t &written,uint32_t &nextExtension,
+			uint32_t &nextOther,uint8_t *buffer);
+
+	/**
+	 * Write the next attribute of a kind outside the credentials.
+	 * @param type attribute type, sOtherAttribute_id for the attributes not handled
+	 * @param[in,out] nextCredential index of the next credential to write
+	 * @param[in,out] nextExtension index of the next vendor extension to write
+	 * @param[in,out] nextOther offset of the next attribute not handled to write
+	 * @param buffer buffer where write the attribute
+	 * @return number of write bytes, 0 if there isn't an attribute left of that kind
+	 */
+	uint32_t write_attribute(fieldType_t type,uint32_t &nextCredential,
+			uint32_t &nextExtension,uint32_t &nextOther,uint8_t *buffer) const;
+
+	/**
+	 * Compute the number of bytes used by the credential attributes.
+	 * @param credential credential to encode
+	 * @return length of the credential content, without the credential attribute header
+	 */
+	static uint32_t get_credential_length(const WifiCredential_t &credential);
+
+	/**
+	 * Write a credential attribute.
+	 * @param credential credential to encode
+	 * @param buffer buffer where write the attribute
 	 * @return number of write bytes
 	 */
-	template<typename T>
-	uint32_t write_data_field(const fieldType_t& dataType,
-			const T& data, uint8_t *buffer);
+	static uint32_t write_credential(const WifiCredential_t &credential,uint8_t *buffer);
+
+	/**
+	 * Read the content of a credential attribute.
+	 * @param buffer credential content
+	 * @param length credential content length
+	 * @param[out] credential object where store the read data
+	 * @return false if an attribute is malformed or exceeds the credential
+	 */
+	static bool parse_credential(const uint8_t *buffer,uint32_t length,
+			WifiCredential_t &credential);
 
 	/**
-	 * write a data buffer inside the output buffer
-	 * @param dataType field type
-	 * @param data buffer where read the data
-	 * @param size number of byte to move
-	 * @param out output buffer
+	 * Write an attribute into the output buffer.
+	 * @param dataType attribute type
+	 * @param data attribute content
+	 * @param size number of bytes of the content
+	 * @param buffer buffer where write the attribute
 	 * @return number of write bytes
 	 */
-	uint32_t write_data_field(const fieldType_t& dataType,
-			const char *data,const fieldLenght_t& size, uint8_t *buffer);
+	static uint32_t write_data_field(const fieldType_t& dataType,
+			const void *data,const fieldLenght_t& size, uint8_t *buffer);
 
-	std::string mSsid;
-	std::string mPasskey;
-	authType_t mAuthType;
-	encryptionType_t mEncType;
+	/**
+	 * Write a 16bit value attribute into the output buffer.
+	 * @param dataType attribute type
+	 * @param data attribute value
+	 * @param buffer buffer where write the attribute
+	 * @return number of write bytes
+	 */
+	static uint32_t write_data_field(const fieldType_t& dataType,
+			const uint16_t data, uint8_t *buffer);
 
-	bool mContentIsChange; ///< true if we have to update the string representation of the data
-	uint8_t *mMimeData; //< buffer where store the record playload
-	fieldLenght_t mMimeDataLenght;
+	std::vector<WifiCredential_t> mCredentials;
+	std::vector<std::string> mVendorExtensions; ///< vendor extensions outside the credentials
+	std::string mOtherAttributes; ///< attributes outside the credentials not handled by this class
+	std::vector<fieldType_t> mAttributeOrder; ///< attribute types outside the credentials in reading order
 
+	bool mContentIsChange; ///< true if we have to update the payload length
 
 	static const std::string sWifiConfMimeType;
 	static const fieldType_t sCredentialField_id;
@@ -221,8 +394,10 @@ private:
 	static const fieldType_t sNetworkKeyField_id;
 	static const fieldType_t sAuthTypeField_id;
 	static const fieldType_t sEncTypeField_id;
+	static const fieldType_t sMacAddressField_id;
+	static const fieldType_t sVendorExtensionField_id;
+	static const fieldType_t sOtherAttribute_id; ///< kind stored in the attribute order for the attributes not handled
 };
 }
 
 #endif /* NDEFLIB_RECORDTYPE_RECORDWIFICONF_H_ */
-
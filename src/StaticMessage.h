@@ -0,0 +1,344 @@
+/**
+ ******************************************************************************
+ * @file    StaticMessage.h
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   Build a NDEF file at compile time
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+#ifndef NDEFLIB_STATICMESSAGE_H_
+#define NDEFLIB_STATICMESSAGE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "RecordURI.h"
+
+namespace NDefLib {
+
+/**
+ * Build the image of a NDEF file at compile time, for tags with a fixed content.
+ * @par The image contains the message length and the records with the right
+ * MB/ME/SR flags, so it can be stored in flash and written as it is with
+ * {@link NDefNfcTag#write_ndef_file}, without building any {@link Record} object.
+ * @code
+ * static constexpr auto sTagContent = NDefLib::StaticMessage::message(
+ *		NDefLib::StaticMessage::uri_record(NDefLib::RecordURI::HTTPS_WWW,"st.com"),
+ *		NDefLib::StaticMessage::aar_record("com.st.demo"));
+ * tag.write_ndef_file(sTagContent.data,sTagContent.length());
+ * @endcode
+ * @par The strings are used without the terminating '\0'.
+ */
+class StaticMessage {
+private:
+
+	/**
+	 * Header flags, see RecordHeader
+	 */
+	enum {
+		MB_FLAG = 0x80,
+		ME_FLAG = 0x40,
+		SR_FLAG = 0x10
+	};
+
+	/**
+	 * Sum of the template parameters.
+	 */
+	template<size_t ... N>
+	struct Sum;
+
+	/**
+	 * Last template parameter.
+	 */
+	template<size_t ... N>
+	struct Last;
+
+	/**
+	 * Number of bytes of a record with the given type and payload length.
+	 */
+	template<size_t T, size_t P>
+	struct RecordLength {
+		static const size_t value = (P <= 0xFF ? 3 : 6) + T + P;
+	};
+
+	/**
+	 * Tag used to select the record header format.
+	 */
+	template<bool IsShort>
+	struct ShortRecord {
+	};
+
+	/**
+	 * Compile time list of indexes, used to build the arrays.
+	 */
+	template<size_t ... I>
+	struct Indexes {
+	};
+
+	/**
+	 * Append the second list to the first one, shifting its values.
+	 */
+	template<typename A, typename B>
+	struct JoinIndexes;
+
+	/**
+	 * Build the index list 0..N-1 with a recursion depth of log(N).
+	 */
+	template<size_t N>
+	struct IndexList;
+
+public:
+
+	/**
+	 * Sequence of bytes built at compile time.
+	 */
+	template<size_t N>
+	struct Bytes {
+		/** byte content, one dummy byte is used when N==0 */
+		uint8_t data[N == 0 ? 1 : N];
+
+		/**
+		 * @return number of valid bytes
+		 */
+		constexpr uint16_t length() const {
+			return N;
+		}
+	};
+
+	/**
+	 * Build a NFC well known URI record.
+	 * @param prefix Abbreviation of the URI.
+	 * @param content URI without the prefix.
+	 */
+	template<size_t C>
+	static constexpr Bytes<RecordLength<1, C>::value> uri_record(
+			const RecordURI::knowUriId_t prefix, const char (&content)[C]) {
+		return record(RecordHeader::NFC_well_known, to_bytes("U"),
+				concat(to_byte(prefix), to_bytes(content)));
+	}
+
+	/**
+	 * Build an UTF8 NFC well known text record.
+	 * @param language Language code (ISO/IANA), at most 63 chars.
+	 * @param text Record text.
+	 */
+	template<size_t L, size_t T>
+	static constexpr Bytes<RecordLength<1, L + T - 1>::value> text_record(
+			const char (&language)[L], const char (&text)[T]) {
+		static_assert(L - 1 < 64, "the language code is too long");
+		return record(RecordHeader::NFC_well_known, to_bytes("T"),
+				concat(to_byte(L - 1), to_bytes(language), to_bytes(text)));
+	}
+
+	/**
+	 * Build an Android Application Record.
+	 * @param packageName Android package to start.
+	 */
+	template<size_t P>
+	static constexpr Bytes<RecordLength<15, P - 1>::value> aar_record(
+			const char (&packageName)[P]) {
+		return record(RecordHeader::NFC_external, to_bytes("android.com:pkg"),
+				to_bytes(packageName));
+	}
+
+	/**
+	 * Build a MIME record.
+	 * @param mimeType MIME type of the data.
+	 * @param data Record data.
+	 */
+	template<size_t M, size_t D>
+	static constexpr Bytes<RecordLength<M - 1, D - 1>::value> mime_record(
+			const char (&mimeType)[M], const char (&data)[D]) {
+		return record(RecordHeader::Mime_media_type, to_bytes(mimeType),
+				to_bytes(data));
+	}
+
+	/**
+	 * Build a NFC Forum external type record.
+	 * @param type domain:type string.
+	 * @param data Record data.
+	 */
+	template<size_t T, size_t D>
+	static constexpr Bytes<RecordLength<T - 1, D - 1>::value> external_record(
+			const char (&type)[T], const char (&data)[D]) {
+		return record(RecordHeader::NFC_external, to_bytes(type),
+				to_bytes(data));
+	}
+
+	/**
+	 * Build the NDEF file: the message length followed by the records.
+	 * @param first First record of the message.
+	 * @param others Other records of the message.
+	 * @return NDEF file image
+	 */
+	template<size_t N, size_t ... R>
+	static constexpr Bytes<2 + Sum<N, R...>::value> message(
+			const Bytes<N> &first, const Bytes<R> &... others) {
+		static_assert(Sum<N, R...>::value <= 0xFFFF, "the message is too long");
+		return concat(to_bytes_u16(Sum<N, R...>::value),
+				set_message_flags(concat(first, others...),
+						Sum<N, R...>::value - Last<N, R...>::value,
+						typename IndexList<Sum<N, R...>::value>::type()));
+	}
+
+private:
+
+	template<size_t N, size_t ... I>
+	static constexpr Bytes<N - 1> to_bytes(const char (&str)[N],
+			Indexes<I...>) {
+		return Bytes<N - 1> { { (uint8_t) str[I]... } };
+	}
+
+	/**
+	 * Convert a string literal without the terminating '\0'.
+	 */
+	template<size_t N>
+	static constexpr Bytes<N - 1> to_bytes(const char (&str)[N]) {
+		return to_bytes(str, typename IndexList<N - 1>::type());
+	}
+
+	static constexpr Bytes<1> to_byte(const uint8_t value) {
+		return Bytes<1> { { value } };
+	}
+
+	/**
+	 * 16 bit value, most significant byte first.
+	 */
+	static constexpr Bytes<2> to_bytes_u16(const uint16_t value) {
+		return Bytes<2> { { (uint8_t) (value >> 8), (uint8_t) (value & 0xFF) } };
+	}
+
+	template<size_t A, size_t B, size_t ... I>
+	static constexpr Bytes<A + B> concat(const Bytes<A> &a, const Bytes<B> &b,
+			Indexes<I...>) {
+		return Bytes<A + B> { { (uint8_t) (I < A ? a.data[I] : b.data[I - A])... } };
+	}
+
+	template<size_t A>
+	static constexpr Bytes<A> concat(const Bytes<A> &a) {
+		return a;
+	}
+
+	template<size_t A, size_t B, size_t ... R>
+	static constexpr Bytes<Sum<A, B, R...>::value> concat(const Bytes<A> &a,
+			const Bytes<B> &b, const Bytes<R> &... others) {
+		return concat(concat(a, b, typename IndexList<A + B>::type()), others...);
+	}
+
+	/**
+	 * Short record header: the payload length fits in a byte.
+	 */
+	template<size_t T, size_t P>
+	static constexpr Bytes<3> record_header(
+			const RecordHeader::TypeNameFormat_t tnf, ShortRecord<true>) {
+		return Bytes<3> { { (uint8_t) (tnf | SR_FLAG), (uint8_t) T, (uint8_t) P } };
+	}
+
+	/**
+	 * Record header with a 4 bytes payload length.
+	 */
+	template<size_t T, size_t P>
+	static constexpr Bytes<6> record_header(
+			const RecordHeader::TypeNameFormat_t tnf, ShortRecord<false>) {
+		return Bytes<6> { { (uint8_t) tnf, (uint8_t) T, (uint8_t) (P >> 24),
+				(uint8_t) (P >> 16), (uint8_t) (P >> 8), (uint8_t) P } };
+	}
+
+	/**
+	 * Build a record without the MB/ME flags.
+	 */
+	template<size_t T, size_t P>
+	static constexpr Bytes<RecordLength<T, P>::value> record(
+			const RecordHeader::TypeNameFormat_t tnf, const Bytes<T> &type,
+			const Bytes<P> &payload) {
+		static_assert(T > 0 && T <= 0xFF, "the record type must be 1-255 chars");
+		return concat(record_header<T, P>(tnf, ShortRecord<(P <= 0xFF)>()),
+				type, payload);
+	}
+
+	/**
+	 * Set the MB flag in the first record and the ME flag in the last one.
+	 */
+	template<size_t N, size_t ... I>
+	static constexpr Bytes<N> set_message_flags(const Bytes<N> &records,
+			const size_t lastRecordOffset, Indexes<I...>) {
+		return Bytes<N> { { (uint8_t) (records.data[I]
+				| (I == 0 ? MB_FLAG : 0)
+				| (I == lastRecordOffset ? ME_FLAG : 0))... } };
+	}
+};
+
+template<>
+struct StaticMessage::Sum<> {
+	static const size_t value = 0;
+};
+
+template<size_t N, size_t ... R>
+struct StaticMessage::Sum<N, R...> {
+	static const size_t value = N + Sum<R...>::value;
+};
+
+template<size_t N>
+struct StaticMessage::Last<N> {
+	static const size_t value = N;
+};
+
+template<size_t N, size_t M, size_t ... R>
+struct StaticMessage::Last<N, M, R...> {
+	static const size_t value = Last<M, R...>::value;
+};
+
+template<size_t ... I, size_t ... J>
+struct StaticMessage::JoinIndexes<StaticMessage::Indexes<I...>,
+		StaticMessage::Indexes<J...> > {
+	typedef Indexes<I..., (sizeof...(I) + J)...> type;
+};
+
+template<size_t N>
+struct StaticMessage::IndexList {
+	typedef typename JoinIndexes<typename IndexList<N / 2>::type,
+			typename IndexList<N - N / 2>::type>::type type;
+};
+
+template<>
+struct StaticMessage::IndexList<0> {
+	typedef Indexes<> type;
+};
+
+template<>
+struct StaticMessage::IndexList<1> {
+	typedef Indexes<0> type;
+};
+
+} /* namespace NDefLib */
+
+#endif /* NDEFLIB_STATICMESSAGE_H_ */
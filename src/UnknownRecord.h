@@ -0,0 +1,91 @@
+/**
+ ******************************************************************************
+ * @file    UnknownRecord.h
+ * @author  ST / Central Labs
+ * @version V2.0.0
+ * @date    18 Oct 2026
+ * @brief   Record not handled by the library
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+#ifndef NDEFLIB_RECORDTYPE_UNKNOWNRECORD_H_
+#define NDEFLIB_RECORDTYPE_UNKNOWNRECORD_H_
+
+#include "RecordBinary.h"
+
+namespace NDefLib {
+
+/**
+ * Record that is not recognized by any other class.
+ * @par The type name format, type, id and payload are kept as they are read, so
+ * that the record is written back without changes.
+ */
+class UnknownRecord: public RecordBinary {
+public:
+
+	/**
+	 * Create an UnknownRecord reading the data from the buffer.
+ 	 * @param header Record header.
+	 * @param buffer Buffer to read the data from.
+	 * @return an object of type UnknownRecord
+	 * @par User is in charge of freeing the pointer returned by this function.
+	 */
+	static UnknownRecord* parse(const RecordHeader &header,
+			const uint8_t *buffer);
+
+	/**
+	 * Create a new record.
+	 * @param tnf Type name format.
+	 * @param type Record type.
+	 * @param id Record id, empty if the record has not an id.
+	 * @param data Payload, it is copied inside the class.
+	 * @param dataLength Payload length in bytes.
+	 */
+	UnknownRecord(RecordHeader::TypeNameFormat_t tnf, const std::string &type,
+			const std::string &id, const uint8_t *data=NULL,
+			uint32_t dataLength=0):
+		RecordBinary(tnf,type,data,dataLength){
+		set_id(id);
+	}
+
+	/**
+	 * Compare two objects
+	 * @return true if the 2 records have the same type name format, type, id and payload
+	 */
+	bool operator==(const UnknownRecord &other) const {
+		return get_id()==other.get_id() && RecordBinary::operator==(other);
+	}
+
+	virtual ~UnknownRecord() { }
+};
+
+} /* namespace NDefLib */
+
+#endif /* NDEFLIB_RECORDTYPE_UNKNOWNRECORD_H_ */
@@ -169,6 +169,10 @@ typedef enum {
 #define M24SR_DESELECTRESPONSE_NBBYTE							3
 #define M24SR_WATINGTIMEEXTRESPONSE_NBBYTE				4
 #define M24SR_PASSWORD_NBBYTE											0x10
+/* max number of bytes read or wrote by a single command */
+#define M24SR_MAX_BYTE_OPERATION_LENGHT					(246)
+/* PCB, DID, CLA, INS, P1, P2, LC, password, CRC: longest command built by the driver */
+#define M24SR_MAX_COMMAND_NBBYTE								(7+M24SR_PASSWORD_NBBYTE+M24SR_CRC_NBBYTE)
 #define M24SR_SELECTAPPLICATION_COMMAND	{0xD2,0x76,0x00,0x00,0x85,0x01,0x01}
 /*  Command structure	------------------------------------------------------------------------*/
 #define M24SR_CMDSTRUCT_SELECTAPPLICATION					0x01FF